@@ -387,6 +387,7 @@ typedef struct
     void        (*FreeData)(dhtValue);
     void        (*DumpData)(dhtConstValue,FILE *);
     void        (*DumpKey)(dhtConstValue,FILE *);
+    size_t      (*KeySize)(dhtConstValue);
 } Procedures;
 
 typedef struct dht {
@@ -453,9 +454,13 @@ dht *dhtCreate(dhtValueType KeyType, dhtValuePolicy KeyPolicy,
     sprintf(dhtError,
             "dhtCreate: no procedure registered for DtaType \"%s\"\n",
             dhtValueTypeToString[DtaType]);
-  else if (KeyPolicy!=dhtNoCopy && KeyPolicy!=dhtCopy)
+  else if (KeyPolicy!=dhtNoCopy && KeyPolicy!=dhtCopy && KeyPolicy!=dhtInline)
     sprintf(dhtError,
             "Sorry, unknown KeyPolicy: numeric=%u.", KeyPolicy);
+  else if (KeyPolicy==dhtInline && dhtProcedures[KeyType]->Size==0)
+    sprintf(dhtError,
+            "dhtCreate: KeyType \"%s\" can't be stored inline\n",
+            dhtValueTypeToString[KeyType]);
   else if (DataPolicy!=dhtNoCopy && DataPolicy!=dhtCopy)
     sprintf(dhtError,
             "Sorry, unknown DataPolicy: numeric=%u.", DataPolicy);
@@ -492,8 +497,9 @@ dht *dhtCreate(dhtValueType KeyType, dhtValuePolicy KeyPolicy,
         ht->procs.Equal=    dhtProcedures[KeyType]->Equal;
         ht->procs.DumpData= dhtProcedures[DtaType]->Dump;
         ht->procs.DumpKey=  dhtProcedures[KeyType]->Dump;
+        ht->procs.KeySize=  dhtProcedures[KeyType]->Size;
 
-        if (KeyPolicy==dhtNoCopy)
+        if (KeyPolicy==dhtNoCopy || KeyPolicy==dhtInline)
         {
           ht->procs.DupKey= dhtProcedures[dhtSimpleValue]->Dup;
           ht->procs.FreeKey= dhtProcedures[dhtSimpleValue]->Free;
@@ -526,6 +532,47 @@ dht *dhtCreate(dhtValueType KeyType, dhtValuePolicy KeyPolicy,
   return result;
 }
 
+/* Allocate an element for a new key; with KeyPolicy dhtInline, the key is
+ * copied into memory allocated behind the element
+ */
+LOCAL InternHsElement *NewElement(HashTable *ht, dhtConstValue key)
+{
+  if (ht->KeyPolicy==dhtInline)
+  {
+    size_t const PtrMask = sizeof(void *)-1;
+    size_t const KeySize = (ht->procs.KeySize)(key);
+    /* fxf aligns chunks whose size is a multiple of the pointer size */
+    size_t const Size = (sizeof(InternHsElement)+KeySize+PtrMask) & ~PtrMask;
+    InternHsElement * const result = (InternHsElement *)fxfAlloc(Size);
+    if (result!=NilInternHsElement)
+    {
+      memcpy(result+1,key,KeySize);
+      result->HsEl.Key = result+1;
+    }
+    return result;
+  }
+  else
+    return NewInternHsElement;
+}
+
+/* Free an element together with its key
+ */
+LOCAL void FreeElement(HashTable *ht, InternHsElement *he)
+{
+  if (ht->KeyPolicy==dhtInline)
+  {
+    size_t const PtrMask = sizeof(void *)-1;
+    size_t const KeySize = (ht->procs.KeySize)(he->HsEl.Key);
+    size_t const Size = (sizeof(InternHsElement)+KeySize+PtrMask) & ~PtrMask;
+    fxfFree(he,Size);
+  }
+  else
+  {
+    (ht->procs.FreeKey)(he->HsEl.Key);
+    FreeInternHsElement(he);
+  }
+}
+
 void dhtDestroy(HashTable *ht)
 {
   dirEnumerate dEnum;
@@ -542,10 +589,9 @@ void dhtDestroy(HashTable *ht)
     while (b)
     {
       InternHsElement *tmp= b;
-      (ht->procs.FreeKey)(b->HsEl.Key);
       (ht->procs.FreeData)(b->HsEl.Data);
       b= b->Next;
-      FreeInternHsElement(tmp);
+      FreeElement(ht,tmp);
     }
 
   freeDirTable(&ht->DirTab);
@@ -653,6 +699,45 @@ dhtElement *dhtGetNextElement(HashTable *ht)
   return dhtNilElement;
 }
 
+/* Start stepping through the elements at a bucket other than the first one
+ * (wrapping around to the first one if the table has shrunk meanwhile);
+ * continue with dhtGetNextElement()
+ */
+dhtElement *dhtGetFirstElementFromBucket(HashTable *ht, unsigned long bucket)
+{
+  dhtElement *result = dhtNilElement;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%p",ht);
+  TraceFunctionParam("%lu",bucket);
+  TraceFunctionParamListEnd();
+
+  if (ht->KeyCount>0)
+  {
+    ht->DirEnum.dt = &ht->DirTab;
+    ht->DirEnum.index = bucket<ht->DirTab.count ? bucket : 0;
+    if ((ht->DirEnum.index & DIR_IDX_MASK)!=0)
+      /* stepDirTable() only fetches the current dir at its first index */
+      ht->DirEnum.current = (ht_dir*)accessAdr(&ht->DirTab,
+                                               ht->DirEnum.index & ~(uLong)DIR_IDX_MASK);
+    ht->NextStep = NilInternHsElement;
+    result = dhtGetNextElement(ht);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%p",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Determine the bucket where stepping through the elements would continue
+ * if it were interrupted now
+ */
+unsigned long dhtGetNextBucket(HashTable *ht)
+{
+  return ht->DirEnum.index;
+}
+
 LOCAL uLong DynamicHash(uLong p, uLong maxp, dhtHashValue v)
 {
   uLong const h = v % maxp;
@@ -831,8 +916,7 @@ void dhtRemoveElement(HashTable *ht, dhtValue key)
 
     *phe= he->Next;
     (ht->procs.FreeData)(he->HsEl.Data);
-    (ht->procs.FreeKey)(he->HsEl.Key);
-    FreeInternHsElement(he);
+    FreeElement(ht,he);
     ht->KeyCount--;
     if (ActualLoadFactor(ht) < ht->MinLoadFactor)
     {
@@ -870,7 +954,7 @@ dhtElement *dhtEnterElement(HashTable *ht, dhtConstValue key, dhtValue data)
   TraceFunctionParamListEnd();
 
   assert(key!=0);
-  KeyV = (ht->procs.DupKey)(key);
+  KeyV = ht->KeyPolicy==dhtInline ? (dhtValue)key : (ht->procs.DupKey)(key);
   if (KeyV==0)
   {
     TraceText("key duplication failed\n");
@@ -898,7 +982,7 @@ dhtElement *dhtEnterElement(HashTable *ht, dhtConstValue key, dhtValue data)
   TraceEOL();
   if (he==0)
   {
-    he = NewInternHsElement;
+    he = NewElement(ht,key);
     TraceValue("%p",he);
     TraceEOL();
     if (he==0)
@@ -916,6 +1000,8 @@ dhtElement *dhtEnterElement(HashTable *ht, dhtConstValue key, dhtValue data)
       *phe = he;
       he->Next = NilInternHsElement;
       ht->KeyCount++;
+      if (ht->KeyPolicy==dhtInline)
+        KeyV = he->HsEl.Key;
     }
   }
   else
@@ -924,6 +1010,8 @@ dhtElement *dhtEnterElement(HashTable *ht, dhtConstValue key, dhtValue data)
       (ht->procs.FreeData)(he->HsEl.Data);
     if (ht->KeyPolicy == dhtCopy)
       (ht->procs.FreeKey)(he->HsEl.Key);
+    else if (ht->KeyPolicy == dhtInline)
+      KeyV = he->HsEl.Key;
   }
 
   he->HsEl.Key = KeyV;
@@ -9,8 +9,11 @@
  * comment with the above copyright notice is keept intact
  * and in place.
  */
+/* dhtInline: the key is copied into the hash table element itself, saving an
+ * allocation and a dereference per element; only for value types that
+ * define the Size procedure */
 typedef enum {
-	dhtCopy, dhtNoCopy
+	dhtCopy, dhtNoCopy, dhtInline
 } dhtValuePolicy;
 
 /* Now finally this is the HashElement */
@@ -35,6 +38,8 @@ void	      dhtRemoveElement	(struct dht *, dhtValue key);
 dhtElement   *dhtLookupElement	(struct dht *, dhtConstValue key);
 dhtElement   *dhtGetFirstElement(struct dht *);
 dhtElement   *dhtGetNextElement	(struct dht *);
+dhtElement   *dhtGetFirstElementFromBucket(struct dht *, unsigned long bucket);
+unsigned long dhtGetNextBucket	(struct dht *);
 unsigned long dhtKeyCount	(struct dht *);
 char const   *dhtErrorMsg	();
 
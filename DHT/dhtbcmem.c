@@ -74,6 +74,12 @@ static void FreeBCMemVal(dhtValue v)
   fxfFree(freed,size);
 }
 
+static size_t SizeBCMemValue(dhtConstValue v)
+{
+  BCMemValue const * const measured = (BCMemValue *)v;
+  return sizeof *measured - sizeof measured->Data + measured->Leng;
+}
+
 static void DumpBCMemValue(dhtConstValue v, FILE *f)
 {
   BCMemValue const * const toBeDumped = (BCMemValue *)v;
@@ -100,5 +106,6 @@ dhtValueProcedures dhtBCMemoryProcs =
   EqualBCMemValue,
   DupBCMemValue,
   FreeBCMemVal,
-  DumpBCMemValue
+  DumpBCMemValue,
+  SizeBCMemValue
 };
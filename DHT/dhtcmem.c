@@ -81,5 +81,6 @@ dhtValueProcedures dhtCompactMemoryProcs = {
   EqualCompactMemoryValue,
   DupCompactMemoryValue,
   FreeCompactMemoryValue,
-  DumpCompactMemoryValue
+  DumpCompactMemoryValue,
+  0 /* not stored inline */
 };
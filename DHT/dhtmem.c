@@ -84,5 +84,6 @@ dhtValueProcedures dhtMemoryProcs = {
   EqualMemoryValue,
   DupMemoryValue,
   FreeMemoryValue,
-  DumpMemoryValue
+  DumpMemoryValue,
+  0 /* not stored inline */
 };
@@ -85,5 +85,6 @@ dhtValueProcedures dhtSimpleProcs =
   EqualSimpleValue,
   DupSimpleValue,
   FreeSimpleValue,
-  DumpSimpleValue
+  DumpSimpleValue,
+  0 /* not stored inline */
 };
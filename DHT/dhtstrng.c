@@ -68,5 +68,6 @@ dhtValueProcedures dhtStringProcs = {
 	EqualString,
 	DupString,
 	FreeString,
-	DumpString
+	DumpString,
+	0 /* not stored inline */
 };
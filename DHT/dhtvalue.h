@@ -82,6 +82,7 @@ typedef struct {
 	dhtValue	(*Dup)(dhtConstValue);
 	void		(*Free)(dhtValue);
 	void		(*Dump)(dhtConstValue, FILE *);
+	size_t		(*Size)(dhtConstValue);	/* optional */
 } dhtValueProcedures;
 
 #if defined(REGISTER_SIMPLE)
@@ -15,6 +15,7 @@
 #endif /*__TURBOC__*/
 
 #include "fxf.h"
+#include "platform/huge_pages.h"
 
 #if !defined(Nil) && !defined(New) && !defined(nNew)
 #  define Nil(type)      (type *)0
@@ -59,6 +60,8 @@ typedef struct {
     unsigned long  MallocCount;
     unsigned long  FreeCount;
     char *    FreeHead;
+    unsigned long  MaxMallocCount;  /* highest MallocCount since init/reset */
+    unsigned long  FailCount;       /* number of failed allocations */
 } SizeHead;
 
 #if defined(DOS)
@@ -93,6 +96,9 @@ enum
 
 static SizeHead SizeData[fxfMAXSIZE+1];
 
+/* number of allocations refused because the size was > fxfMAXSIZE */
+static unsigned long TooLargeCount;
+
 #if defined(SEGMENTED)
 /* #define  ARENA_SEG_SIZE  32000 */
 /* #define  ARENA_SEG_COUNT  ((1024*1024)/ARENA_SEG_SIZE) */
@@ -214,8 +220,8 @@ int fxfInit(size_t Size) {
   GlobalSize= ArenaSegCnt*ARENA_SEG_SIZE;
 #else
   if (Arena)
-    free(Arena);
-  if ((Arena=nNew(Size, char)) == Nil(char)) {
+    platform_free_huge_pages(Arena, GlobalSize);
+  if ((Arena=platform_allocate_huge_pages(Size)) == Nil(char)) {
     ERROR_LOG2("%s: Sorry, cannot allocate arena of %lu bytes\n",
                myname, Size);
     BotFreePtr= Arena;
@@ -236,6 +242,7 @@ int fxfInit(size_t Size) {
 #endif /*FREEMAP, !SEGMENTED*/
 
   memset(SizeData, '\0', sizeof(SizeData));
+  TooLargeCount= 0;
 
   return 0;
 }
@@ -264,15 +271,8 @@ void fxfReset(void)
 #endif /*FREEMAP*/
 #endif /*SEGMENTED*/
 
-#if !defined(NDEBUG)
-  {
-    unsigned int i;
-    for (i = 1; i<=50; ++i)
-      assert(SizeData[i].MallocCount==0);
-  }
-#endif
-
   memset(SizeData, '\0', sizeof SizeData);
+  TooLargeCount= 0;
 }
 
 /* we have to define the following, since some architectures cannot
@@ -309,6 +309,7 @@ void *fxfAlloc(size_t size) {
                myname,
                (unsigned int)size,
                (unsigned int)fxfMAXSIZE);
+    TooLargeCount++;
     return Nil(char);
   }
   if ( (size&PTRMASK) && size<ALIGNED_MINSIZE)
@@ -320,6 +321,8 @@ void *fxfAlloc(size_t size) {
     sh->FreeHead= GetNextPtr(ptr);
     sh->FreeCount--;
     sh->MallocCount++;
+    if (sh->MallocCount>sh->MaxMallocCount)
+      sh->MaxMallocCount= sh->MallocCount;
     ClrRange((char *)ptr-Arena, size);
     TMDBG(printf(" FreeCount:%lu ptr-Arena:%ld MallocCount:%lu\n",sh->FreeCount,(char*)ptr-Arena,sh->MallocCount));
   }
@@ -338,6 +341,8 @@ void *fxfAlloc(size_t size) {
         ptr= TopFreePtr-= size;
       }
       sh->MallocCount++;
+      if (sh->MallocCount>sh->MaxMallocCount)
+        sh->MaxMallocCount= sh->MallocCount;
       TMDBG(printf(" current seg ptr-Arena:%ld MallocCount:%lu\n",(char*)ptr-Arena,sh->MallocCount));
     }
     else
@@ -350,10 +355,13 @@ void *fxfAlloc(size_t size) {
         TopFreePtr= Arena[CurrentSeg]+ARENA_SEG_SIZE;
         ptr= fxfAlloc(size);
       }
-      else
+      else {
         ptr= Nil(char);
+        sh->FailCount++;
+      }
 #else /*SEGMENTED*/
       ptr= Nil(char);
+      sh->FailCount++;
 #endif /*!SEGMENTED*/
       TMDBG(printf(" ptr:%p\n",ptr));
     }
@@ -455,26 +463,40 @@ void fxfInfo(FILE *f) {
   fprintf(f, "fxfArenaUsed = %lu kB\n",
           (unsigned long)(sizeArenaUsed/one_kilo));
   fprintf(f, "fxfMAXSIZE   = %u B\n", (unsigned int)fxfMAXSIZE);
+  fprintf(f, "fxfTooLarge  = %lu\n", TooLargeCount);
 
   {
     SizeHead const *hd = SizeData;
     unsigned long nrUsed = 0;
     unsigned long nrFree = 0;
+    unsigned long nrFailed = 0;
     size_t UsedBytes = 0;
     size_t FreeBytes = 0;
 
     unsigned int i;
-    fprintf(f, "%12s  %10s%10s\n", "Size", "MallocCnt", "FreeCnt");
+    /* FreeCnt is the number of chunks waiting in the free list of a size;
+     * Frag% the percentage of the chunks carved for a size that are waiting
+     * there */
+    fprintf(f, "%12s  %10s%10s%10s%10s%7s\n",
+            "Size", "MallocCnt", "FreeCnt", "MaxCnt", "FailCnt", "Frag%");
     for (i=0; i<=fxfMAXSIZE; i++,hd++) {
-      if (hd->MallocCount+hd->FreeCount>0) {
-        fprintf(f, "%12u  %10lu%10lu\n", i, hd->MallocCount, hd->FreeCount);
+      if (hd->MallocCount+hd->FreeCount+hd->FailCount>0) {
+        unsigned long const nrCarved = hd->MallocCount+hd->FreeCount;
+        fprintf(f, "%12u  %10lu%10lu%10lu%10lu%7lu\n",
+                i,
+                hd->MallocCount, hd->FreeCount,
+                hd->MaxMallocCount, hd->FailCount,
+                nrCarved==0 ? 0 : hd->FreeCount*100/nrCarved);
         nrUsed+= hd->MallocCount;
         UsedBytes+= hd->MallocCount*i;
         nrFree+= hd->FreeCount;
         FreeBytes+= hd->FreeCount*i;
+        nrFailed+= hd->FailCount;
       }
     }
-    fprintf(f, "%12s  %10lu%10lu\n", "Total:", nrUsed, nrFree);
+    fprintf(f, "%12s  %10lu%10lu%10s%10lu%7lu\n",
+            "Total:", nrUsed, nrFree, "", nrFailed,
+            nrUsed+nrFree==0 ? 0 : nrFree*100/(nrUsed+nrFree));
     assert(UsedBytes/one_kilo<=ULONG_MAX);
     assert(FreeBytes/one_kilo<=ULONG_MAX);
     fprintf(f, "%12s  %10lu%10lu\n", "Total kB:",
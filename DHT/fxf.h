@@ -8,11 +8,16 @@ int fxfInitialised(void);
 void *fxfAlloc(size_t size);
 void *fxfReAlloc(void *ptr, size_t OldSize, size_t NewSize);
 void fxfFree(void *ptr, size_t size);
+/* Write statistics to a file: per size, the number of chunks allocated,
+ * waiting in the free list, allocated at the same time at most, and the
+ * number of failed allocations */
 void fxfInfo(FILE *);
 size_t fxfTotal();
 
 /* Reset the internal data structures to the state that was reached
- * after the latest call to fxfInit() */
+ * after the latest call to fxfInit(). All memory allocated with fxfAlloc()
+ * is freed at once; this is much faster than freeing the chunks one by
+ * one. */
 void fxfReset(void);
 
 #endif
@@ -63,6 +63,8 @@ void counters_writer_solve(slice_index si)
   RESET_COUNTER(play_move);
   RESET_COUNTER(is_white_king_square_attacked);
   RESET_COUNTER(is_black_king_square_attacked);
+  RESET_COUNTER(king_square_attack_cache_hit);
+  RESET_COUNTER(removed_slice);
 
   pipe_solve_delegate(si);
 
@@ -70,6 +72,8 @@ void counters_writer_solve(slice_index si)
   WRITE_COUNTER(play_move);
   WRITE_COUNTER(is_white_king_square_attacked);
   WRITE_COUNTER(is_black_king_square_attacked);
+  WRITE_COUNTER(king_square_attack_cache_hit);
+  WRITE_COUNTER(removed_slice);
 }
 
 #endif
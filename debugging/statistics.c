@@ -0,0 +1,469 @@
+#include "debugging/statistics.h"
+#include "stipulation/pipe.h"
+#include "stipulation/move.h"
+#include "stipulation/slice_insertion.h"
+#include "stipulation/help_play/branch.h"
+#include "solving/pipe.h"
+#include "solving/check.h"
+#include "solving/move_generator.h"
+#include "solving/ply.h"
+#include "solving/machinery/slack_length.h"
+#include "optimisations/hash.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    unsigned long nr_moves_played[maxply+1];
+    /* indexed by the length tried when solving by increasing length */
+    unsigned long nr_moves_played_per_length[maxply+1];
+    unsigned long nr_moves_generated;
+    unsigned long nr_check_tests;
+    unsigned long nr_hash_probes;
+    unsigned long nr_hash_hits;
+    unsigned long nr_target_positions_tried;
+    unsigned long nr_target_positions_pruned;
+    clock_t setplay_ticks;
+    clock_t total_ticks;
+} statistics_type;
+
+static boolean is_report_requested;
+
+static unsigned int problem_number;
+static unsigned int twin_number;
+
+/* statistics of the twin currently being solved and of the current problem */
+static statistics_type twin;
+static statistics_type problem;
+
+/* Write the solving statistics of each twin and problem
+ */
+void statistics_request_report(void)
+{
+  is_report_requested = true;
+}
+
+/* Have the solving statistics been requested?
+ * @return true iff the statistics are written
+ */
+boolean statistics_is_report_requested(void)
+{
+  return is_report_requested;
+}
+
+/* Reset the solving statistics, e.g. at the start of a problem
+ */
+void statistics_reset(void)
+{
+  memset(&problem,0,sizeof problem);
+  ++problem_number;
+  twin_number = 0;
+}
+
+static unsigned long ticks_to_msec(clock_t ticks)
+{
+  /* there are implementations with CLOCKS_PER_SEC of type double! */
+  return (unsigned long)((1000.0*ticks)/CLOCKS_PER_SEC);
+}
+
+static void write_statistics(char const *kind, statistics_type const *statistics)
+{
+  char const *separator = "";
+  ply p;
+
+  /* the output written before may not have ended its last line */
+  fprintf(stdout,"\n{\"statistics\":\"%s\",\"problem\":%u",kind,problem_number);
+  if (statistics==&twin)
+    fprintf(stdout,",\"twin\":%u",twin_number);
+
+  fprintf(stdout,",\"time_ms\":{\"setplay\":%lu,\"solution\":%lu,\"total\":%lu}",
+          ticks_to_msec(statistics->setplay_ticks),
+          ticks_to_msec(statistics->total_ticks-statistics->setplay_ticks),
+          ticks_to_msec(statistics->total_ticks));
+
+  fputs(",\"moves_played_per_ply\":{",stdout);
+  for (p = 0; p<=maxply; ++p)
+    if (statistics->nr_moves_played[p]!=0)
+    {
+      fprintf(stdout,"%s\"%u\":%lu",separator,p,statistics->nr_moves_played[p]);
+      separator = ",";
+    }
+  fputs("}",stdout);
+
+  separator = "";
+  fputs(",\"moves_played_per_length\":{",stdout);
+  for (p = 0; p<=maxply; ++p)
+    if (statistics->nr_moves_played_per_length[p]!=0)
+    {
+      fprintf(stdout,"%s\"%u\":%lu",separator,p,statistics->nr_moves_played_per_length[p]);
+      separator = ",";
+    }
+  fputs("}",stdout);
+
+  fprintf(stdout,",\"moves_generated\":%lu",statistics->nr_moves_generated);
+  fprintf(stdout,",\"check_tests\":%lu",statistics->nr_check_tests);
+  fprintf(stdout,",\"hash\":{\"probes\":%lu,\"hits\":%lu}",
+          statistics->nr_hash_probes,
+          statistics->nr_hash_hits);
+  fprintf(stdout,",\"target_positions\":{\"tried\":%lu,\"pruned\":%lu}",
+          statistics->nr_target_positions_tried,
+          statistics->nr_target_positions_pruned);
+  fputs("}\n",stdout);
+  fflush(stdout);
+}
+
+static void add_twin_to_problem(void)
+{
+  ply p;
+
+  for (p = 0; p<=maxply; ++p)
+  {
+    problem.nr_moves_played[p] += twin.nr_moves_played[p];
+    problem.nr_moves_played_per_length[p] += twin.nr_moves_played_per_length[p];
+  }
+
+  problem.nr_moves_generated += twin.nr_moves_generated;
+  problem.nr_check_tests += twin.nr_check_tests;
+  problem.nr_hash_probes += twin.nr_hash_probes;
+  problem.nr_hash_hits += twin.nr_hash_hits;
+  problem.nr_target_positions_tried += twin.nr_target_positions_tried;
+  problem.nr_target_positions_pruned += twin.nr_target_positions_pruned;
+  problem.setplay_ticks += twin.setplay_ticks;
+  problem.total_ticks += twin.total_ticks;
+}
+
+/* Write the statistics of the current problem to stdout if this has been
+ * requested
+ */
+void statistics_report_of_problem(void)
+{
+  if (is_report_requested)
+    write_statistics("problem",&problem);
+}
+
+/* Instrument the solving machinery of a twin with the slices writing the
+ * statistics if these have been requested
+ * @param si identifies the slice where to start the instrumentation
+ */
+void statistics_instrument_twin(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (is_report_requested)
+  {
+    slice_index const prototype = alloc_pipe(STStatisticsWriter);
+    slice_insertion_insert(si,&prototype,1);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_writer_solve(slice_index si)
+{
+  clock_t const start = clock();
+  unsigned long nr_hash_probes;
+  unsigned long nr_hash_hits;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  memset(&twin,0,sizeof twin);
+  ++twin_number;
+
+  hash_get_statistics_total(&nr_hash_probes,&nr_hash_hits);
+
+  pipe_solve_delegate(si);
+
+  {
+    unsigned long nr_hash_probes_after;
+    unsigned long nr_hash_hits_after;
+    hash_get_statistics_total(&nr_hash_probes_after,&nr_hash_hits_after);
+    twin.nr_hash_probes = nr_hash_probes_after-nr_hash_probes;
+    twin.nr_hash_hits = nr_hash_hits_after-nr_hash_hits;
+  }
+
+  twin.total_ticks = clock()-start;
+
+  add_twin_to_problem();
+  write_statistics("twin",&twin);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_move_counter_solve(slice_index si)
+{
+  ++twin.nr_moves_played[nbply];
+  pipe_solve_delegate(si);
+}
+
+/* Generate moves for the current piece, counting them
+ * @param si identifies the generator slice
+ */
+void statistics_move_generation_counter_solve(slice_index si)
+{
+  numecoup const before = CURRMOVE_OF_PLY(nbply);
+  pipe_move_generation_delegate(si);
+  twin.nr_moves_generated += CURRMOVE_OF_PLY(nbply)-before;
+}
+
+/* Count a check test
+ * @param si identifies the check tester
+ * @param side_in_check which side?
+ * @return true iff side_in_check is in check according to slice si
+ */
+boolean statistics_check_test_counter_is_in_check(slice_index si,
+                                                  Side side_in_check)
+{
+  ++twin.nr_check_tests;
+  return pipe_is_in_check_recursive_delegate(si,side_in_check);
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_setplay_timer_solve(slice_index si)
+{
+  clock_t const start = clock();
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  pipe_solve_delegate(si);
+
+  twin.setplay_ticks += clock()-start;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_target_position_candidate_counter_solve(slice_index si)
+{
+  unsigned long const nr_tried_before = twin.nr_target_positions_tried;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  pipe_solve_delegate(si);
+
+  /* the target position tester has rejected the candidate position without
+   * trying to reach it */
+  if (twin.nr_target_positions_tried==nr_tried_before)
+    ++twin.nr_target_positions_pruned;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_target_position_counter_solve(slice_index si)
+{
+  ++twin.nr_target_positions_tried;
+  pipe_solve_delegate(si);
+}
+
+static unsigned long nr_moves_played_in_twin(void)
+{
+  unsigned long result = 0;
+  ply p;
+
+  for (p = 0; p<=maxply; ++p)
+    result += twin.nr_moves_played[p];
+
+  return result;
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_length_counter_solve(slice_index si)
+{
+  unsigned long const nr_played_before = nr_moves_played_in_twin();
+  stip_length_type const length = solve_nr_remaining-slack_length;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  pipe_solve_delegate(si);
+
+  assert(length<=maxply);
+  twin.nr_moves_played_per_length[length] += nr_moves_played_in_twin()-nr_played_before;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_setplay_timer(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children(si,st);
+
+  {
+    slice_index const timer = alloc_pipe(STStatisticsSetplayTimer);
+    pipe_set_successor(timer,SLICE_NEXT2(si));
+    SLICE_NEXT2(si) = timer;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_length_counter(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  {
+    slice_index const prototype = alloc_pipe(STStatisticsLengthCounter);
+    help_branch_insert_slices(si,&prototype,1);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_target_position_counters(slice_index si,
+                                            stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  {
+    slice_index const prototypes[] = {
+        alloc_pipe(STStatisticsTargetPositionCandidateCounter),
+        alloc_pipe(STStatisticsTargetPositionCounter)
+    };
+    enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
+    help_branch_insert_slices(si,prototypes,nr_prototypes);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Instrument the solving machinery with the slices collecting the statistics
+ * if these have been requested
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_statistics_counters(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (is_report_requested)
+  {
+    stip_instrument_moves(si,STStatisticsMoveCounter);
+    solving_instrument_move_generation(si,nr_sides,STStatisticsMoveGenerationCounter);
+    solving_instrument_check_testing(si,STStatisticsCheckTestCounter);
+
+    {
+      stip_structure_traversal st;
+      stip_structure_traversal_init(&st,0);
+      stip_structure_traversal_override_single(&st,
+                                               STSetplayFork,
+                                               &insert_setplay_timer);
+      stip_structure_traversal_override_single(&st,
+                                               STFindByIncreasingLength,
+                                               &insert_length_counter);
+      stip_structure_traversal_override_single(&st,
+                                               STIntelligentFilter,
+                                               &insert_target_position_counters);
+      stip_traverse_structure(si,&st);
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,156 @@
+#if !defined(DEBUGGING_STATISTICS_H)
+#define DEBUGGING_STATISTICS_H
+
+#include "stipulation/stipulation.h"
+#include "utilities/boolean.h"
+#include "position/side.h"
+
+/* This module implements the statistics about the solving process that can
+ * be requested at run time with the command line option -stats:
+ * - number of moves played per ply
+ * - number of moves played per length tried when solving by increasing length
+ * - number of moves generated
+ * - number of check tests
+ * - number of hash table probes and hits
+ * - number of target positions tried and pruned in intelligent mode
+ * - processor time used for set play and for the solution (including tries)
+ * For each twin and each problem, the statistics are written to stdout as a
+ * single line holding a JSON object.
+ * If the statistics haven't been requested, the solving machinery isn't
+ * instrumented at all.
+ */
+
+/* Write the solving statistics of each twin and problem
+ */
+void statistics_request_report(void);
+
+/* Have the solving statistics been requested?
+ * @return true iff the statistics are written
+ */
+boolean statistics_is_report_requested(void);
+
+/* Reset the solving statistics, e.g. at the start of a problem
+ */
+void statistics_reset(void);
+
+/* Write the statistics of the current problem to stdout if this has been
+ * requested
+ */
+void statistics_report_of_problem(void);
+
+/* Instrument the solving machinery of a twin with the slices writing the
+ * statistics if these have been requested
+ * @param si identifies the slice where to start the instrumentation
+ */
+void statistics_instrument_twin(slice_index si);
+
+/* Instrument the solving machinery with the slices collecting the statistics
+ * if these have been requested
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_statistics_counters(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_writer_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_move_counter_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_length_counter_solve(slice_index si);
+
+/* Generate moves for the current piece, counting them
+ * @param si identifies the generator slice
+ */
+void statistics_move_generation_counter_solve(slice_index si);
+
+/* Count a check test
+ * @param si identifies the check tester
+ * @param side_in_check which side?
+ * @return true iff side_in_check is in check according to slice si
+ */
+boolean statistics_check_test_counter_is_in_check(slice_index si,
+                                                  Side side_in_check);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_setplay_timer_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_target_position_candidate_counter_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void statistics_target_position_counter_solve(slice_index si);
+
+#endif
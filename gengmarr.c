@@ -146,6 +146,33 @@ static void dump_castling_rights_initialiser_to_stream(FILE *dest, position cons
   fprintf(dest,"  0x%x /* castling_rights */\n",pos->castling_rights);
 }
 
+/* Write bitboards initialiser to output file
+ * @param dest destination stream (output file)
+ * @param bitboards address of bitboards
+ */
+static void dump_bitboards_initialiser_to_stream(FILE *dest,
+                                                 bitboards_type const *bitboards)
+{
+  Side side;
+
+  fputs("  , { /* bitboards */\n",dest);
+  fprintf(dest,"      0x%llxULL,\n",bitboards->occupied);
+  fprintf(dest,"      { 0x%llxULL, 0x%llxULL },\n",
+          bitboards->side[White],bitboards->side[Black]);
+  fputs("      {\n",dest);
+  for (side = White; side!=nr_sides; ++side)
+  {
+    unsigned int i;
+    fputs("        { ",dest);
+    for (i = 0; i!=nr_bitboard_walks-1; ++i)
+      fprintf(dest,"0x%llxULL, ",bitboards->walk[side][i]);
+    fprintf(dest,"0x%llxULL }%s\n",bitboards->walk[side][i],side==White ? "," : "");
+  }
+  fputs("      },\n",dest);
+  fprintf(dest,"      0x%llxULL\n",bitboards->modified);
+  fputs("    }\n",dest);
+}
+
 /* Write position initialiser to output file
  * @param dest destination stream (output file)
  * @param pos array of position object containing initial position
@@ -167,6 +194,9 @@ static void dump_position_initialiser_to_stream(FILE *dest, position const *pos)
   fputs(",\n",dest);
   dump_castling_rights_initialiser_to_stream(dest,pos);
   fputs("  , 0 /* currPieceId */\n",dest);
+  fprintf(dest,"  , { { 0x%llxULL, 0x%llxULL } } /* hash_key */\n",
+          pos->hash_key.word[0],pos->hash_key.word[1]);
+  dump_bitboards_initialiser_to_stream(dest,&pos->bitboards);
   fputs("};\n",dest);
 }
 
@@ -5,10 +5,13 @@
 #include "platform/maxtime.h"
 #include "platform/maxmem.h"
 #include "input/plaintext/memory.h"
+#include "solving/workers.h"
 #include "stipulation/pipe.h"
 #include "solving/pipe.h"
 #include "debugging/trace.h"
+#include "debugging/statistics.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -52,6 +55,56 @@ static int parseCommandlineOptions(int argc, char *argv[])
       idx += 2;
       continue;
     }
+    else if (idx+1<argc && strcmp(argv[idx],"-hashtable")==0)
+    {
+      idx++;
+      if (strcmp(argv[idx],"fixed")==0)
+        hash_use_fixed_size_table();
+      else
+      {
+        /* the language of the messages isn't known before the input has
+         * been read */
+        fprintf(stderr,"-hashtable: unknown kind of hash table: %s\n",argv[idx]);
+        exit(1);
+      }
+      idx++;
+      continue;
+    }
+    else if (idx+1<argc && strcmp(argv[idx],"-workers")==0)
+    {
+      char *end;
+      unsigned long value;
+      idx++;
+      value = strtoul(argv[idx], &end, 10);
+      if (argv[idx]==end)
+        ; /* conversion failure -> don't use workers */
+      else if (value>1)
+      {
+        workers_set_number((unsigned int)value);
+        /* the workers share the fixed size hash table */
+        hash_use_fixed_size_table();
+      }
+      idx++;
+      continue;
+    }
+    else if (idx+1<argc && strcmp(argv[idx],"-hashfile")==0)
+    {
+      hash_set_snapshot_file(argv[idx+1]);
+      idx += 2;
+      continue;
+    }
+    else if (strcmp(argv[idx],"-hashstats")==0)
+    {
+      hash_request_statistics_report();
+      idx++;
+      continue;
+    }
+    else if (strcmp(argv[idx],"-stats")==0)
+    {
+      statistics_request_report();
+      idx++;
+      continue;
+    }
     else if (strcmp(argv[idx], "-regression")==0)
     {
       protocol_overwrite();
@@ -41,6 +41,7 @@
 #include "platform/maxtime.h"
 #include "debugging/trace.h"
 #include "debugging/measure.h"
+#include "debugging/statistics.h"
 #include "debugging/assert.h"
 
 #include <ctype.h>
@@ -790,6 +791,8 @@ void solving_machinery_intro_builder_solve(slice_index si)
     slice_insertion_insert(si,prototypes,nr_prototypes);
   }
 
+  statistics_instrument_twin(si);
+
   solving_impose_starter(si,SLICE_STARTER(si));
 
   pipe_solve_delegate(si);
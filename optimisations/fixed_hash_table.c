@@ -0,0 +1,346 @@
+#include "optimisations/fixed_hash_table.h"
+#include "platform/worker.h"
+#include "debugging/trace.h"
+#include "debugging/assert.h"
+
+#include <limits.h>
+#include <string.h>
+
+/* The table may be shared between worker processes that access it without
+ * locking. An entry therefore doesn't hold its signature, but the signature
+ * xor'ed with the data. An entry whose fields have been written
+ * concurrently by different processes then (almost certainly) doesn't match
+ * any signature and is ignored.
+ */
+typedef struct
+{
+    hash_key_type check; /* signature ^ data */
+    fixed_hash_table_data_type data;
+    unsigned int generation; /* entry is unused if <oldest_valid_generation */
+} entry_type;
+
+enum
+{
+  cache_line_size = 64,
+  nr_entries_per_bucket = cache_line_size/sizeof(entry_type)
+};
+
+typedef struct
+{
+    entry_type entries[nr_entries_per_bucket];
+} bucket_type;
+
+/* Clearing the table only starts a new generation; the entries of the
+ * previous generations are then treated as unused. The generations are
+ * shared with the worker processes like the buckets.
+ */
+typedef struct
+{
+    unsigned int current;
+    unsigned int oldest_valid;
+    boolean are_buckets_initialised;
+} generations_type;
+
+static void *allocated_memory;
+static size_t allocated_size;
+static generations_type *generations;
+static bucket_type *buckets;
+static unsigned long bucket_index_mask;
+
+static fixed_hash_table_value_fct_type value_of_entry;
+static unsigned long nr_stored_entries;
+static unsigned long nr_replacements;
+static unsigned long nr_replacements_in_generation;
+
+/* Allocate the table. If the requested amount of memory isn't
+ * available, reduce the amount until allocation succeeds.
+ * The table is allocated in memory that is shared with worker processes
+ * started later.
+ * @param nr_kilos number of kilo-bytes to allocate
+ * @return number of kilo-bytes actually allocated
+ */
+unsigned long fixed_hash_table_allocate(unsigned long nr_kilos)
+{
+  unsigned long result = 0;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%lu",nr_kilos);
+  TraceFunctionParamListEnd();
+
+  assert(allocated_memory==0);
+
+  while (nr_kilos>0)
+  {
+    allocated_size = nr_kilos*1024;
+    allocated_memory = platform_allocate_shared_memory(allocated_size);
+    if (allocated_memory==0)
+      nr_kilos /= 2;
+    else
+    {
+      /* the generations occupy the first cache line; the number of buckets
+       * is a power of two, and memory exceeding the largest such number that
+       * fits is left unused */
+      size_t const misalignment = (size_t)allocated_memory%cache_line_size;
+      size_t const usable = allocated_size-2*cache_line_size;
+      unsigned long nr_buckets = 1;
+      while (2*nr_buckets*sizeof(bucket_type)<=usable)
+        nr_buckets *= 2;
+      generations = (generations_type *)((char *)allocated_memory
+                                         + (cache_line_size-misalignment)%cache_line_size);
+      generations->are_buckets_initialised = false;
+      buckets = (bucket_type *)((char *)generations + cache_line_size);
+      bucket_index_mask = nr_buckets-1;
+      result = nr_kilos;
+      break;
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%lu",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Determine whether the table has been allocated
+ * @return true iff the table has been allocated
+ */
+boolean fixed_hash_table_is_allocated(void)
+{
+  return allocated_memory!=0;
+}
+
+/* Deallocate the table
+ */
+void fixed_hash_table_free(void)
+{
+  platform_free_shared_memory(allocated_memory,allocated_size);
+  allocated_memory = 0;
+  allocated_size = 0;
+  generations = 0;
+  buckets = 0;
+  bucket_index_mask = 0;
+}
+
+/* Replace the table that the invoking worker process shares with the other
+ * workers by a table of its own; the memory of the shared table is divided
+ * between the workers.
+ * @param nr_workers number of workers
+ */
+void fixed_hash_table_unshare(unsigned int nr_workers)
+{
+  unsigned long const nr_kilos = allocated_size/1024/nr_workers;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",nr_workers);
+  TraceFunctionParamListEnd();
+
+  assert(allocated_memory!=0);
+  assert(nr_workers>0);
+
+  /* this only unmaps the shared memory in the invoking process; the memory
+   * allocated instead isn't shared with any other process */
+  fixed_hash_table_free();
+  fixed_hash_table_allocate(nr_kilos==0 ? 1 : nr_kilos);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Remove all entries from the table
+ * @param value function used to rank entries if one has to be replaced
+ */
+void fixed_hash_table_clear(fixed_hash_table_value_fct_type value)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  assert(buckets!=0);
+
+  if (generations->are_buckets_initialised && generations->current<UINT_MAX)
+    ++generations->current;
+  else
+  {
+    memset(buckets,0,(bucket_index_mask+1)*sizeof(bucket_type));
+    generations->current = 1;
+    generations->are_buckets_initialised = true;
+  }
+
+  generations->oldest_valid = generations->current;
+
+  value_of_entry = value;
+  nr_stored_entries = 0;
+  nr_replacements = 0;
+  nr_replacements_in_generation = 0;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static bucket_type *find_bucket(hash_key_type signature)
+{
+  /* the low bits are used for the bucket index, but all bits are compared */
+  return buckets + (unsigned long)(signature&bucket_index_mask);
+}
+
+/* Look up an entry
+ * @param signature signature of the encoded position
+ * @param data where to copy the data of the entry to
+ * @return true iff there is an entry for the signature
+ */
+boolean fixed_hash_table_lookup(hash_key_type signature,
+                                fixed_hash_table_data_type *data)
+{
+  bucket_type const * const bucket = find_bucket(signature);
+  unsigned int i;
+
+  for (i = 0; i!=nr_entries_per_bucket; ++i)
+  {
+    entry_type const * const entry = bucket->entries+i;
+    fixed_hash_table_data_type const entry_data = entry->data;
+    if (entry->generation>=generations->oldest_valid
+        && (entry->check^entry_data)==signature)
+    {
+      *data = entry_data;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* Find the entry of a bucket to be replaced
+ * @param bucket address of full bucket
+ * @return address of the least valuable entry of *bucket
+ */
+static entry_type *find_replacement_victim(bucket_type *bucket)
+{
+  entry_type *result = bucket->entries;
+  unsigned int const current_generation = generations->current;
+  boolean result_is_current = result->generation==current_generation;
+  unsigned int result_value = (*value_of_entry)(&result->data);
+  unsigned int i;
+
+  for (i = 1; i!=nr_entries_per_bucket; ++i)
+  {
+    entry_type * const entry = bucket->entries+i;
+    boolean const is_current = entry->generation==current_generation;
+    if (is_current && !result_is_current)
+      continue;
+    else
+    {
+      unsigned int const value = (*value_of_entry)(&entry->data);
+      if ((result_is_current && !is_current) || value<result_value)
+      {
+        result = entry;
+        result_is_current = is_current;
+        result_value = value;
+      }
+    }
+  }
+
+  return result;
+}
+
+/* Store the data of an entry. If there is no entry for the signature yet,
+ * one is entered, replacing another one if necessary.
+ * @param signature signature of the encoded position
+ * @param data data of the entry
+ */
+void fixed_hash_table_store(hash_key_type signature,
+                            fixed_hash_table_data_type data)
+{
+  bucket_type * const bucket = find_bucket(signature);
+  entry_type *entry = 0;
+  unsigned int i;
+
+  for (i = 0; i!=nr_entries_per_bucket; ++i)
+  {
+    entry_type * const candidate = bucket->entries+i;
+    if (candidate->generation<generations->oldest_valid)
+    {
+      if (entry==0)
+        entry = candidate;
+    }
+    else if ((candidate->check^candidate->data)==signature)
+    {
+      entry = candidate;
+      break;
+    }
+  }
+
+  if (entry==0)
+  {
+    entry = find_replacement_victim(bucket);
+    ++nr_replacements;
+
+    /* start a new generation once there has been about one replacement per
+     * bucket; entries of older generations are replaced first */
+    ++nr_replacements_in_generation;
+    if (nr_replacements_in_generation>bucket_index_mask
+        && generations->current<UINT_MAX)
+    {
+      ++generations->current;
+      nr_replacements_in_generation = 0;
+    }
+  }
+  else if (entry->generation<generations->oldest_valid)
+    ++nr_stored_entries;
+
+  entry->check = signature^data;
+  entry->data = data;
+  entry->generation = generations->current;
+}
+
+/* Visit the entries stored since the table was last cleared
+ * @param visitor invoked for each entry
+ * @param param passed on to visitor
+ */
+void fixed_hash_table_visit(fixed_hash_table_visitor_type visitor, void *param)
+{
+  unsigned long b;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  assert(buckets!=0);
+
+  for (b = 0; b<=bucket_index_mask; ++b)
+  {
+    unsigned int i;
+    for (i = 0; i!=nr_entries_per_bucket; ++i)
+    {
+      entry_type const * const entry = buckets[b].entries+i;
+      fixed_hash_table_data_type const data = entry->data;
+      if (entry->generation>=generations->oldest_valid)
+        (*visitor)(entry->check^data,data,param);
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine the number of entries currently stored in the table
+ * @return number of entries
+ */
+unsigned long fixed_hash_table_count(void)
+{
+  return nr_stored_entries;
+}
+
+/* Determine the number of entries that have been replaced since the
+ * table was last cleared
+ * @return number of entries
+ */
+unsigned long fixed_hash_table_nr_replacements(void)
+{
+  return nr_replacements;
+}
+
+/* Determine the number of entries the table can hold
+ * @return number of entries
+ */
+unsigned long fixed_hash_table_capacity(void)
+{
+  return buckets==0 ? 0 : (bucket_index_mask+1)*nr_entries_per_bucket;
+}
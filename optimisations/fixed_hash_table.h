@@ -0,0 +1,110 @@
+#if !defined(OPTIMISATIONS_FIXED_HASH_TABLE_H)
+#define OPTIMISATIONS_FIXED_HASH_TABLE_H
+
+/* Fixed size hash table (a.k.a. transposition table)
+ *
+ * An alternative to the dynamic hash table implemented in the DHT
+ * directory. The table is a flat, power-of-two sized array of cache line
+ * sized buckets. Each bucket holds a few entries consisting of a 64bit
+ * signature of an encoded position and the hash data of the position.
+ * There is no allocation once the table has been created, and a probe
+ * typically touches a single cache line.
+ *
+ * If a bucket is full, the least valuable entry of the bucket is replaced,
+ * where entries stored before the current generation are considered less
+ * valuable than all the entries stored during the current generation.
+ *
+ * The table lives in shared memory and can be accessed by several worker
+ * processes at the same time. Data is therefore copied out of and into the
+ * table rather than accessed in place.
+ */
+
+#include "position/position.h"
+#include "utilities/boolean.h"
+
+typedef unsigned int fixed_hash_table_data_type;
+
+/* Callback used to rank entries when one of them has to be replaced
+ * @param data address of an entry's data
+ * @return value of the entry; the higher, the more we want to keep it
+ */
+typedef unsigned int (*fixed_hash_table_value_fct_type)(fixed_hash_table_data_type const *data);
+
+/* Allocate the table. If the requested amount of memory isn't
+ * available, reduce the amount until allocation succeeds.
+ * The table is allocated in memory that is shared with worker processes
+ * started later.
+ * @param nr_kilos number of kilo-bytes to allocate
+ * @return number of kilo-bytes actually allocated
+ */
+unsigned long fixed_hash_table_allocate(unsigned long nr_kilos);
+
+/* Determine whether the table has been allocated
+ * @return true iff the table has been allocated
+ */
+boolean fixed_hash_table_is_allocated(void);
+
+/* Deallocate the table
+ */
+void fixed_hash_table_free(void);
+
+/* Replace the table that the invoking worker process shares with the other
+ * workers by a table of its own; the memory of the shared table is divided
+ * between the workers.
+ * @param nr_workers number of workers
+ */
+void fixed_hash_table_unshare(unsigned int nr_workers);
+
+/* Remove all entries from the table
+ * @param value function used to rank entries if one has to be replaced
+ */
+void fixed_hash_table_clear(fixed_hash_table_value_fct_type value);
+
+/* Look up an entry
+ * @param signature signature of the encoded position
+ * @param data where to copy the data of the entry to
+ * @return true iff there is an entry for the signature
+ */
+boolean fixed_hash_table_lookup(hash_key_type signature,
+                                fixed_hash_table_data_type *data);
+
+/* Store the data of an entry. If there is no entry for the signature yet,
+ * one is entered, replacing another one if necessary.
+ * @param signature signature of the encoded position
+ * @param data data of the entry
+ */
+void fixed_hash_table_store(hash_key_type signature,
+                            fixed_hash_table_data_type data);
+
+/* Callback used to visit the entries of the table
+ * @param signature signature of an entry's encoded position
+ * @param data data of the entry
+ * @param param parameter passed to fixed_hash_table_visit()
+ */
+typedef void (*fixed_hash_table_visitor_type)(hash_key_type signature,
+                                              fixed_hash_table_data_type data,
+                                              void *param);
+
+/* Visit the entries stored since the table was last cleared
+ * @param visitor invoked for each entry
+ * @param param passed on to visitor
+ */
+void fixed_hash_table_visit(fixed_hash_table_visitor_type visitor, void *param);
+
+/* Determine the number of entries currently stored in the table
+ * @return number of entries
+ */
+unsigned long fixed_hash_table_count(void);
+
+/* Determine the number of entries that have been replaced since the
+ * table was last cleared
+ * @return number of entries
+ */
+unsigned long fixed_hash_table_nr_replacements(void);
+
+/* Determine the number of entries the table can hold
+ * @return number of entries
+ */
+unsigned long fixed_hash_table_capacity(void);
+
+#endif
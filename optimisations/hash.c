@@ -24,18 +24,17 @@
 /**********************************************************************
  ** We hash.
  **
- ** SmallEncode and LargeEncode are functions to encode the current
- ** position. SmallEncode is used when the starting position contains
- ** less than or equal to eight pieces. LargeEncode is used when more
- ** pieces are present. The function TellSmallEncode and TellLargeEncode
- ** are used to decide what encoding to use. Which function to use is
- ** stored in encode.
- ** SmallEncode encodes for each piece the square where it is located.
- ** LargeEncode uses the old scheme introduced by Torsten: eight
- ** bytes at the beginning give in 64 bits the locations of the pieces
- ** coded after the eight bytes. Both functions give for each piece its
- ** type (1 byte) and specification (2 bytes). After this information
- ** about en_passant_multistep_over[0]-captures, Duellants and Imitators are coded.
+ ** ZobristEncode and ProofEncode are functions to encode the current
+ ** position. ZobristEncode doesn't scan the board, but copies the key of
+ ** the position that the functions in position.c maintain incrementally
+ ** while pieces are added, moved and removed; the key is the XOR of one
+ ** pseudo-random pair of words per (square, piece type, specification),
+ ** where the specification is restricted to the bytes_per_spec bytes that
+ ** the encoding of a piece would use. ProofEncode
+ ** encodes the entire board because proof games compare positions with the
+ ** target position. Which function to use is stored in encode.
+ ** Both functions then add information about ghosts,
+ ** en_passant_multistep_over[0]-captures, Duellants and Imitators.
  **
  ** The hash table uses a dynamic hashing scheme which allows dynamic
  ** growth and shrinkage of the hashtable. See the relevant dht* files
@@ -48,14 +47,17 @@
  **
  ** When there is no more memory, or more than hash_max_number_storable_positions positions
  ** are stored in the hash-table, then some positions are removed
- ** from the table. This is done in the compress procedure.
- ** This procedure uses a little improved scheme introduced by Torsten.
+ ** from the table. This is done in the evict_elements procedure, a little
+ ** at a time whenever an element can't be entered.
+ ** The procedure used to sweep the entire table at once, using a little
+ ** improved scheme introduced by Torsten.
  ** The selection of positions to remove is based on the value of
  ** information gathered about this position. The information about
  ** a position "unsolvable in 2 moves" is less valuable than "unsolvable
  ** in 5 moves", since the former can be recomputed faster. For the other
  ** type of information ("solvable") the comparison is the other way round.
- ** The compression of the table is an expensive operation, in a lot
+ ** Sweeping the entire table was an expensive operation (causing stalls of
+ ** several seconds in large tables), although in a lot
  ** of exeperiments it has shown to be quite effective in keeping the
  ** most valuable information, and speeds up the computation time
  ** considerably. But to be of any use, there must be enough memory to
@@ -80,10 +82,14 @@
 #include "debugging/assert.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 #include <limits.h>
+#include <time.h>
 
 #include <memory.h>
 #include "optimisations/hash.h"
+#include "optimisations/fixed_hash_table.h"
 #include "output/plaintext/message.h"
 #include "solving/proofgames.h"
 #include "DHT/dhtvalue.h"
@@ -100,6 +106,7 @@
 #include "solving/castling.h"
 #include "solving/machinery/slack_length.h"
 #include "solving/has_solution_type.h"
+#include "solving/workers.h"
 #include "stipulation/proxy.h"
 #include "stipulation/battle_play/branch.h"
 #include "stipulation/help_play/branch.h"
@@ -124,6 +131,10 @@ typedef unsigned int hash_value_type;
 
 static struct dht *pyhash;
 
+/* use a fixed size table instead of pyhash? */
+static boolean is_fixed_size_table_used;
+static boolean is_fixed_size_table_unshared;
+
 static char    piece_nbr[nr_piece_walks];
 static boolean one_byte_hash;
 static unsigned int bytes_per_spec;
@@ -134,12 +145,62 @@ static unsigned int bytes_per_piece;
 static boolean is_table_uncompressed;
 
 /* Minimal value of a hash table element.
- * compresshash() will remove all elements with a value less than
+ * evict_elements() will remove elements with a value less than
  * minimalElementValueAfterCompression, and increase
  * minimalElementValueAfterCompression if necessary.
  */
 static hash_value_type minimalElementValueAfterCompression;
 
+/* Bucket of the dynamic hash table where evict_elements() continues its
+ * sweep, and number of elements it has visited since it last removed one
+ */
+static unsigned long eviction_clock_hand;
+static unsigned long nr_elements_visited_without_eviction;
+
+/* Statistics about evictions from the dynamic hash table */
+static unsigned long nr_evicted_elements;
+static unsigned long nr_compressions;
+static clock_t eviction_clock_ticks;
+
+/* Statistics about the use of the hash table, per hash slice (indexed like
+ * hash_slices) and per ply. Evictions and compressions are attributed to the
+ * insertion that caused them.
+ */
+typedef struct
+{
+    unsigned long nr_probes;
+    unsigned long nr_hits;
+    unsigned long nr_inserts;
+    unsigned long nr_evictions;
+    unsigned long nr_compressions;
+} hash_statistics_type;
+
+static hash_statistics_type slice_statistics[max_nr_slices];
+static hash_statistics_type ply_statistics[maxply+1];
+
+static boolean is_statistics_report_requested;
+
+/* Snapshot of the hash table: file requested by the user, the opener whose
+ * table is saved and restored, and the fingerprint of the problem solved by
+ * it */
+static char const *snapshot_file_name;
+static slice_index snapshot_opener = no_slice;
+static hash_key_type snapshot_fingerprint;
+
+/* The snapshot may only be written while this is set, e.g. not before the
+ * table has been restored */
+static sig_atomic_t volatile is_snapshot_writable;
+
+/* A termination signal received while the snapshot is writable is only
+ * remembered by the signal handler; writing the snapshot isn't possible from
+ * there. It is dealt with by the hash slices, where the table is
+ * consistent. */
+static sig_atomic_t volatile pending_termination_signal;
+
+/* Likewise, a report of the statistics requested by a signal (cf.
+ * hash_schedule_statistics_report()) is written by the hash slices */
+static sig_atomic_t volatile is_statistics_report_pending;
+
 
 /* Container of indices of hash slices
  */
@@ -165,7 +226,6 @@ static void dump_hash_buffer(void)
 #if defined(__unix)
 #include <unistd.h>
 static void *OldBreak;
-extern int dhtDebug;
 #endif /*__unix*/
 #else
 #define ifTESTHASH(x)
@@ -218,6 +278,7 @@ typedef struct
 {
     unsigned int size;
     unsigned int valueOffset;
+    unsigned int hash_slice_index; /* index of the slice in hash_slices */
 
     union
     {
@@ -424,6 +485,7 @@ static void init_slice_properties_attack_hashed(slice_index si,
   slice_properties[si].u.d.offsetSucc = sis->nrBitsLeft;
   slice_properties[si].u.d.maskSucc = mask << sis->nrBitsLeft;
 
+  slice_properties[si].hash_slice_index = nr_hash_slices;
   hash_slices[nr_hash_slices++] = si;
   stip_traverse_structure_children_pipe(si,st);
 
@@ -504,6 +566,7 @@ static void init_slice_properties_hashed_help(slice_index si,
 
   stip_traverse_structure_children_pipe(si,st);
 
+  slice_properties[si].hash_slice_index = nr_hash_slices;
   hash_slices[nr_hash_slices++] = si;
 
   TraceFunctionExit(__func__);
@@ -527,7 +590,7 @@ enum
 /* Reduce the value offsets for the hash slices to the minimal
  * possible value. This is important in order for
  * minimalElementValueAfterCompression not to grow too high in
- * compresshash().
+ * evict_elements().
  */
 static void minimiseValueOffset(void)
 {
@@ -600,14 +663,13 @@ static void init_slice_properties(slice_index si)
 static hashElement_union_t template_element;
 
 
-static void set_value_attack_nosuccess(hashElement_union_t *hue,
+static void set_value_attack_nosuccess(data_type *data,
                                        slice_index si,
                                        hash_value_type val)
 {
   unsigned int const offset = slice_properties[si].u.d.offsetNoSucc;
   unsigned int const bits = val << offset;
   unsigned int const mask = slice_properties[si].u.d.maskNoSucc;
-  element_t * const e = &hue->e;
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParam("%u",val);
@@ -615,27 +677,26 @@ static void set_value_attack_nosuccess(hashElement_union_t *hue,
   TraceValue("%u",slice_properties[si].size);
   TraceValue("%u",offset);
   TraceValue("%08x ",mask);
-  TraceValue("%p",&e->data);
-  TraceValue("pre:%08x ",e->data);
+  TraceValue("%p",data);
+  TraceValue("pre:%08x ",*data);
   TraceValue("%08x",bits);
   TraceEOL();
   assert((bits&mask)==bits);
-  e->data &= ~mask;
-  e->data |= bits;
-  TraceValue("post:%08x",e->data);
+  *data &= ~mask;
+  *data |= bits;
+  TraceValue("post:%08x",*data);
   TraceEOL();
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
 
-static void set_value_attack_success(hashElement_union_t *hue,
+static void set_value_attack_success(data_type *data,
                                      slice_index si,
                                      hash_value_type val)
 {
   unsigned int const offset = slice_properties[si].u.d.offsetSucc;
   unsigned int const bits = val << offset;
   unsigned int const mask = slice_properties[si].u.d.maskSucc;
-  element_t * const e = &hue->e;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
@@ -645,28 +706,27 @@ static void set_value_attack_success(hashElement_union_t *hue,
   TraceValue("%u",slice_properties[si].size);
   TraceValue("%u",offset);
   TraceValue("%08x ",mask);
-  TraceValue("%p",&e->data);
-  TraceValue("pre:%08x ",e->data);
+  TraceValue("%p",data);
+  TraceValue("pre:%08x ",*data);
   TraceValue("%08x",bits);
   TraceEOL();
   assert((bits&mask)==bits);
-  e->data &= ~mask;
-  e->data |= bits;
-  TraceValue("post:%08x",e->data);
+  *data &= ~mask;
+  *data |= bits;
+  TraceValue("post:%08x",*data);
   TraceEOL();
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
 
-static void set_value_help(hashElement_union_t *hue,
+static void set_value_help(data_type *data,
                            slice_index si,
                            hash_value_type val)
 {
   unsigned int const offset = slice_properties[si].u.h.offsetNoSucc;
   unsigned int const bits = val << offset;
   unsigned int const mask = slice_properties[si].u.h.maskNoSucc;
-  element_t * const e = &hue->e;
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParam("%u",val);
@@ -674,31 +734,30 @@ static void set_value_help(hashElement_union_t *hue,
   TraceValue("%u",slice_properties[si].size);
   TraceValue("%u",offset);
   TraceValue("0x%08x ",mask);
-  TraceValue("0x%08x ",&e->data);
-  TraceValue("pre:0x%08x ",e->data);
+  TraceValue("0x%08x ",data);
+  TraceValue("pre:0x%08x ",*data);
   TraceValue("0x%08x",bits);
   TraceEOL();
   assert((bits&mask)==bits);
-  e->data &= ~mask;
-  e->data |= bits;
-  TraceValue("post:0x%08x",e->data);
+  *data &= ~mask;
+  *data |= bits;
+  TraceValue("post:0x%08x",*data);
   TraceEOL();
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
 
-static hash_value_type get_value_attack_success(hashElement_union_t const *hue,
+static hash_value_type get_value_attack_success(data_type const *data,
                                                 slice_index si)
 {
   unsigned int const offset = slice_properties[si].u.d.offsetSucc;
   unsigned int const mask = slice_properties[si].u.d.maskSucc;
-  element_t const * const e = &hue->e;
-  data_type const result = (e->data & mask) >> offset;
+  data_type const result = (*data & mask) >> offset;
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceValue("%08x ",mask);
-  TraceValue("%p",&e->data);
-  TraceValue("%08x",e->data);
+  TraceValue("%p",data);
+  TraceValue("%08x",*data);
   TraceEOL();
 
   TraceFunctionExit(__func__);
@@ -707,18 +766,17 @@ static hash_value_type get_value_attack_success(hashElement_union_t const *hue,
   return result;
 }
 
-static hash_value_type get_value_attack_nosuccess(hashElement_union_t const *hue,
+static hash_value_type get_value_attack_nosuccess(data_type const *data,
                                                   slice_index si)
 {
   unsigned int const offset = slice_properties[si].u.d.offsetNoSucc;
   unsigned int const mask = slice_properties[si].u.d.maskNoSucc;
-  element_t const * const e = &hue->e;
-  data_type const result = (e->data & mask) >> offset;
+  data_type const result = (*data & mask) >> offset;
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceValue("%08x ",mask);
-  TraceValue("%p",&e->data);
-  TraceValue("%08x",e->data);
+  TraceValue("%p",data);
+  TraceValue("%08x",*data);
   TraceEOL();
 
   TraceFunctionExit(__func__);
@@ -727,19 +785,18 @@ static hash_value_type get_value_attack_nosuccess(hashElement_union_t const *hue
   return result;
 }
 
-static hash_value_type get_value_help(hashElement_union_t const *hue,
+static hash_value_type get_value_help(data_type const *data,
                                       slice_index si)
 {
   unsigned int const offset = slice_properties[si].u.h.offsetNoSucc;
   unsigned int const  mask = slice_properties[si].u.h.maskNoSucc;
-  element_t const * const e = &hue->e;
-  data_type const result = (e->data & mask) >> offset;
+  data_type const result = (*data & mask) >> offset;
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceValue("%u",offset);
   TraceValue("0x%08x ",mask);
-  TraceValue("0x%08x ",&e->data);
-  TraceValue("0x%08x",e->data);
+  TraceValue("0x%08x ",data);
+  TraceValue("0x%08x",*data);
   TraceEOL();
 
   TraceFunctionExit(__func__);
@@ -750,11 +807,11 @@ static hash_value_type get_value_help(hashElement_union_t const *hue,
 
 /* Determine the contribution of an attacking move to the value of a
  * hash table element node.
- * @param he address of hash table element to determine value of
+ * @param data address of the data of the hash table element
  * @param si slice index of slice
  * @return value of contribution of slice si to *he's value
  */
-static hash_value_type own_value_of_data_solve(hashElement_union_t const *hue,
+static hash_value_type own_value_of_data_solve(data_type const *data,
                                                 slice_index si)
 {
   stip_length_type const length = SLICE_U(si).branch.length;
@@ -764,12 +821,12 @@ static hash_value_type own_value_of_data_solve(hashElement_union_t const *hue,
   hash_value_type success_neg;
 
   TraceFunctionEntry(__func__);
-  TraceFunctionParam("%p",hue);
+  TraceFunctionParam("%p",data);
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  success = get_value_attack_success(hue,si);
-  nosuccess = get_value_attack_nosuccess(hue,si);
+  success = get_value_attack_success(data,si);
+  nosuccess = get_value_attack_nosuccess(data,si);
 
   assert(success<=length);
   success_neg = length-success;
@@ -784,24 +841,24 @@ static hash_value_type own_value_of_data_solve(hashElement_union_t const *hue,
 
 /* Determine the contribution of a help slice (or leaf slice with help
  * end) to the value of a hash table element node.
- * @param he address of hash table element to determine value of
+ * @param data address of the data of the hash table element
  * @param si slice index of help slice
  * @return value of contribution of slice si to *he's value
  */
-static hash_value_type own_value_of_data_help(hashElement_union_t const *hue,
+static hash_value_type own_value_of_data_help(data_type const *data,
                                               slice_index si)
 {
   unsigned int const parity = slice_properties[si].u.h.parity;
   hash_value_type result;
 
   TraceFunctionEntry(__func__);
-  TraceFunctionParam("%p",hue);
+  TraceFunctionParam("%p",data);
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
   /* double if parity so that the move not leading to the goal (i.e. played
    * earlier) has more value */
-  result = get_value_help(hue,si) << parity;
+  result = get_value_help(data,si) << parity;
 
   TraceFunctionExit(__func__);
   TraceFunctionResult("%u",result);
@@ -811,18 +868,18 @@ static hash_value_type own_value_of_data_help(hashElement_union_t const *hue,
 
 /* Determine the contribution of a slice to the value of a hash table
  * element node.
- * @param he address of hash table element to determine value of
+ * @param data address of the data of the hash table element
  * @param si slice index
- * @return value of contribuation of the slice to *he's value
+ * @return value of contribuation of the slice to the element's value
  */
-static hash_value_type value_of_data_from_slice(hashElement_union_t const *hue,
+static hash_value_type value_of_data_from_slice(data_type const *data,
                                                 slice_index si)
 {
   hash_value_type result;
   unsigned int const offset = slice_properties[si].valueOffset;
 
   TraceFunctionEntry(__func__);
-  TraceFunctionParam("%p",hue);
+  TraceFunctionParam("%p",data);
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
@@ -833,11 +890,11 @@ static hash_value_type value_of_data_from_slice(hashElement_union_t const *hue,
   switch (SLICE_TYPE(si))
   {
     case STAttackHashed:
-      result = own_value_of_data_solve(hue,si) << offset;
+      result = own_value_of_data_solve(data,si) << offset;
       break;
 
     case STHelpHashed:
-      result = own_value_of_data_help(hue,si) << offset;
+      result = own_value_of_data_help(data,si) << offset;
       break;
 
     default:
@@ -855,20 +912,20 @@ static hash_value_type value_of_data_from_slice(hashElement_union_t const *hue,
 /* How much is element *he worth to us? This information is used to
  * determine which elements to discard from the hash table if it has
  * reached its capacity.
- * @param he address of hash table element to determine value of
- * @return value of *he
+ * @param data address of the data of the hash table element
+ * @return value of the element
  */
-static hash_value_type value_of_data(hashElement_union_t const *hue)
+static hash_value_type value_of_data(data_type const *data)
 {
   hash_value_type result = 0;
   unsigned int i;
 
   TraceFunctionEntry(__func__);
-  TraceFunctionParam("%p",hue);
+  TraceFunctionParam("%p",data);
   TraceFunctionParamListEnd();
 
   for (i = 0; i<nr_hash_slices; ++i)
-    result += value_of_data_from_slice(hue,hash_slices[i]);
+    result += value_of_data_from_slice(data,hash_slices[i]);
 
   TraceFunctionExit(__func__);
   TraceFunctionResult("%08x",result);
@@ -876,137 +933,59 @@ static hash_value_type value_of_data(hashElement_union_t const *hue)
   return result;
 }
 
-#if defined(TESTHASH)
-static unsigned long nrElementsRemovedInAllCompressions = 0;
-#endif
-
-static void compresshash (void)
+enum
 {
-  unsigned long targetKeyCount;
+  /* maximal number of elements visited per call of evict_elements() */
+  eviction_step_size = 64
+};
 
-#if defined(TESTHASH)
-  unsigned long nrElementsRemovedInCompression = 0;
-  unsigned long const nrElementsAtStartOfCompression = dhtKeyCount(pyhash);
-  unsigned long nrIterationsInCompression = 0;
-#endif
+/* Remove some elements with little value from the dynamic hash table.
+ * Rather than sweeping the entire table, we do a bounded amount of work per
+ * invokation, continuing where the previous invokation has stopped (like the
+ * hand of a clock). If we visit a sixteenth of the table without finding an
+ * element to remove, the elements with the next higher value become
+ * candidates for removal.
+ */
+static void evict_elements(void)
+{
+  dhtElement const *he = dhtGetFirstElementFromBucket(pyhash,eviction_clock_hand);
+  unsigned int nr_visited = 0;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  is_table_uncompressed = false;
-
-  targetKeyCount = dhtKeyCount(pyhash);
-  targetKeyCount -= targetKeyCount/16;
-
   TraceValue("%u",minimalElementValueAfterCompression);
+  TraceValue("%lu",eviction_clock_hand);
   TraceValue("%lu",dhtKeyCount(pyhash));
-  TraceValue("%lu",targetKeyCount);
   TraceEOL();
 
-  while (true)
-  {
-    dhtElement const *he;
-
-#if defined(TESTHASH)
-    unsigned long nrElementsVisitedInIteration = 0;
-    fprintf(stdout,"starting iteration: minimalElementValueAfterCompression: %u\n",
-           minimalElementValueAfterCompression);
-    fflush(stdout);
-#endif  /* TESTHASH */
+  is_table_uncompressed = false;
+  ++nr_compressions;
 
-#if defined(TESTHASH)
-    for (he = dhtGetFirstElement(pyhash);
-         he!=0;
-         he = dhtGetNextElement(pyhash))
-      fprintf(stdout,"%u\n",value_of_data(he));
-#endif  /* TESTHASH */
-
-    for (he = dhtGetFirstElement(pyhash);
-         he!=0;
-         he = dhtGetNextElement(pyhash))
+  while (he!=dhtNilElement && nr_visited<eviction_step_size)
+  {
+    hashElement_union_t const * const hue = (hashElement_union_t const *)he;
+    ++nr_visited;
+    if (value_of_data(&hue->e.data)<minimalElementValueAfterCompression)
     {
-      hashElement_union_t const * const hue = (hashElement_union_t const *)he;
-      if (value_of_data(hue)<minimalElementValueAfterCompression)
-      {
-#if defined(TESTHASH)
-        ++nrElementsRemovedInCompression;
-        ++nrElementsRemovedInAllCompressions;
-#endif  /* TESTHASH */
-
-        dhtRemoveElement(pyhash, hue->d.Key);
-
-#if defined(TESTHASH)
-        if (nrElementsRemovedInCompression + dhtKeyCount(pyhash) != nrElementsAtStartOfCompression)
-        {
-          fprintf(stdout,
-                  "dhtRemove failed on %lu-th element of iteration %lu. "
-                  "This was the %lu-th call to dhtRemoveElement.\n"
-                  "nrElementsRemovedInCompression=%lu "
-                  "dhtKeyCount=%lu "
-                  "nrElementsAtStartOfCompression=%lu\n",
-                  nrElementsVisitedInIteration,
-                  nrIterationsInCompression,
-                  nrElementsRemovedInAllCompressions,
-                  nrElementsRemovedInCompression,
-                  dhtKeyCount(pyhash),
-                  nrElementsAtStartOfCompression);
-          exit(1);
-        }
-#endif  /* TESTHASH */
-      }
-#if defined(TESTHASH)
-      ++nrElementsVisitedInIteration;
-#endif  /* TESTHASH */
+      dhtRemoveElement(pyhash,hue->d.Key);
+      ++nr_evicted_elements;
+      nr_elements_visited_without_eviction = 0;
     }
-
-#if defined(TESTHASH)
-    ++nrIterationsInCompression;
-    assert(nrElementsAtStartOfCompression>=nrElementsVisitedInIteration);
-    fprintf(stdout,"iteration=%lu, nrElementsRemovedInCompression:%lu, missed:%lu\n",
-           nrIterationsInCompression,
-           nrElementsRemovedInCompression,
-           nrElementsAtStartOfCompression-nrElementsVisitedInIteration);
+    else if (++nr_elements_visited_without_eviction>dhtKeyCount(pyhash)/16)
     {
-      unsigned int i;
-      unsigned int counter[16];
-      unsigned long const KeyCount = dhtKeyCount(pyhash);
-      dhtBucketStat(pyhash,counter,16);
-      for (i=0; i<16; ++i)
-        fprintf(stdout, "%lu %u %u\n", KeyCount, i+1, counter[i]);
-      fputs("\n",stdout);
-      if (nrIterationsInCompression>9)
-        fprintf(stdout,"nrIterationsInCompression > 9 after %lu-th call to  dhtRemoveElement\n",
-               nrElementsRemovedInAllCompressions);
-      dhtDebug = nrIterationsInCompression==9;
+      ++minimalElementValueAfterCompression;
+      nr_elements_visited_without_eviction = 0;
     }
-    fflush(stdout);
-#endif  /* TESTHASH */
 
-    if (dhtKeyCount(pyhash)<=targetKeyCount)
-      break;
-    else
-      ++minimalElementValueAfterCompression;
+    he = dhtGetNextElement(pyhash);
   }
-#if defined(TESTHASH)
-  fprintf(stdout,"%lu;",dhtKeyCount(pyhash));
-#if defined(HASHRATE)
-  fprintf(stdout," usage: %lu", use_pos);
-  fprintf(stdout," / %lu", use_all);
-  fprintf(stdout," = %.1f%%", (100.0 * use_pos) / use_all);
-#endif
-#if defined(FREEMAP) && defined(FXF)
-  PrintFreeMap(stdout);
-#endif /*FREEMAP*/
-  fputs("\n",stdout);
-#if defined(FXF)
-  fputs("\n after compression:\n",stdout);
-  fxfInfo(stdout);
-#endif /*FXF*/
-#endif /*TESTHASH*/
+
+  eviction_clock_hand = he==dhtNilElement ? 0 : dhtGetNextBucket(pyhash);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
-} /* compresshash */
+}
 
 #if defined(HASHRATE)
 /* Level = 0: No output of HashStat
@@ -1262,59 +1241,21 @@ static unsigned int TellCommonEncodePosLeng(unsigned int len,
   return len;
 } /* TellCommonEncodePosLeng */
 
-static unsigned int TellLargeEncodePosLeng(void)
+static unsigned int TellZobristEncodePosLeng(void)
 {
-  square const *bnp;
   unsigned int nbr_p = 0;
-  unsigned int len = 8;
-  unsigned int result;
-
-  TraceFunctionEntry(__func__);
-  TraceFunctionParamListEnd();
-
-  for (bnp= boardnum; *bnp; bnp++)
-    if (!is_square_empty(*bnp))
-    {
-      len += bytes_per_piece;
-      nbr_p++;  /* count no. of pieces and holes */
-    }
-
-  if (CondFlag[BGL])
-    len += sizeof BGL_values[White] + sizeof BGL_values[Black];
-
-  len += nr_ghosts*bytes_per_piece;
-
-  result = TellCommonEncodePosLeng(len, nbr_p);
-
-  TraceFunctionExit(__func__);
-  TraceFunctionResult("%u",result);
-  TraceFunctionResultEnd();
-  return result;
-} /* TellLargeEncodePosLeng */
-
-static unsigned int TellSmallEncodePosLeng(void)
-{
+  unsigned int len = sizeof being_solved.hash_key;
   square const *bnp;
-  unsigned int nbr_p = 0;
-  unsigned int len = 0;
   unsigned int result;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
   for (bnp= boardnum; *bnp; bnp++)
-  {
-    /* piece    p;
-    ** Flags    pspec;
-    */
     if (!is_square_empty(*bnp))
-    {
-      len += 1 + bytes_per_piece;
       nbr_p++;            /* count no. of pieces and holes */
-    }
-  }
 
-  len += nr_ghosts*bytes_per_piece;
+  len += nr_ghosts*(1+bytes_per_piece);
 
   result = TellCommonEncodePosLeng(len, nbr_p);
 
@@ -1322,7 +1263,7 @@ static unsigned int TellSmallEncodePosLeng(void)
   TraceFunctionResult("%u",result);
   TraceFunctionResultEnd();
   return result;
-} /* TellSmallEncodePosLeng */
+} /* TellZobristEncodePosLeng */
 
 byte *CommonEncode(byte *bp,
                    stip_length_type min_length,
@@ -1444,10 +1385,11 @@ byte *CommonEncode(byte *bp,
   return bp;
 } /* CommonEncode */
 
-static byte *LargeEncodePiece(byte *bp, byte *position,
-                              int row, int col,
-                              piece_walk_type pienam, Flags pspec)
+byte *SmallEncodePiece(byte *bp,
+                       int row, int col,
+                       piece_walk_type pienam, Flags pspec)
 {
+  *bp++= (byte)((row<<(CHAR_BIT/2))+col);
   if (one_byte_hash)
     *bp++ = (byte)pspec + ((byte)piece_nbr[pienam] << (CHAR_BIT/2));
   else
@@ -1458,99 +1400,39 @@ static byte *LargeEncodePiece(byte *bp, byte *position,
       *bp++ = (byte)((pspec>>(CHAR_BIT*i)) & ByteMask);
   }
 
-  position[row] |= BIT(col);
-
   return bp;
 }
 
-static void LargeEncode(stip_length_type min_length,
-                        stip_length_type validity_value)
+static void ZobristEncode(stip_length_type min_length,
+                          stip_length_type validity_value)
 {
   HashBuffer *hb = &hashBuffers[nbply];
-  byte *position = hb->cmv.Data;
-  byte *bp = position+nr_rows_on_board;
-  int row, col;
-  square a_square = square_a1;
+  byte *bp = hb->cmv.Data;
+  unsigned int word;
   underworld_index_type gi;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  /* clear the bits for storing the position of pieces */
-  memset(position,0,nr_rows_on_board);
-
-  for (row=0; row<nr_rows_on_board; row++, a_square+= onerow)
+#if defined(TESTHASH)
   {
-    square curr_square = a_square;
-    for (col=0; col<nr_files_on_board; col++, curr_square+= dir_right)
+    position_key_type const recomputed = calculate_hash_key(&being_solved);
+    if (memcmp(&being_solved.hash_key,&recomputed,sizeof recomputed)!=0)
     {
-      piece_walk_type const p = get_walk_of_piece_on_square(curr_square);
-      if (p!=Empty)
-        bp = LargeEncodePiece(bp,position,row,col,p,being_solved.spec[curr_square]);
+      fputs("incrementally maintained hash key is out of sync\n",stdout);
+      exit(1);
     }
   }
+#endif
 
-  for (gi = 0; gi<nr_ghosts; ++gi)
-  {
-    square s = (underworld[gi].on
-                - nr_of_slack_rows_below_board*onerow
-                - nr_of_slack_files_left_of_board);
-    row = s/onerow;
-    col = s%onerow;
-    bp = LargeEncodePiece(bp,position,
-                          row,col,
-                          underworld[gi].walk,underworld[gi].flags);
-  }
-
-  /* Now the rest of the party */
-  bp = CommonEncode(bp,min_length,validity_value);
-
-  assert(bp-hb->cmv.Data<=UCHAR_MAX);
-  hb->cmv.Leng = (unsigned char)(bp-hb->cmv.Data);
-
-  TraceFunctionExit(__func__);
-  TraceFunctionResultEnd();
-} /* LargeEncode */
-
-byte *SmallEncodePiece(byte *bp,
-                       int row, int col,
-                       piece_walk_type pienam, Flags pspec)
-{
-  *bp++= (byte)((row<<(CHAR_BIT/2))+col);
-  if (one_byte_hash)
-    *bp++ = (byte)pspec + ((byte)piece_nbr[pienam] << (CHAR_BIT/2));
-  else
+  for (word = 0; word!=nr_position_key_words; ++word)
   {
+    hash_key_type key = being_solved.hash_key.word[word];
     unsigned int i;
-    *bp++ = pienam;
-    for (i = 0; i<bytes_per_spec; i++)
-      *bp++ = (byte)((pspec>>(CHAR_BIT*i)) & ByteMask);
-  }
-
-  return bp;
-}
-
-static void SmallEncode(stip_length_type min_length,
-                        stip_length_type validity_value)
-{
-  HashBuffer *hb = &hashBuffers[nbply];
-  byte *bp = hb->cmv.Data;
-  square a_square = square_a1;
-  int row;
-  int col;
-  underworld_index_type gi;
-
-  TraceFunctionEntry(__func__);
-  TraceFunctionParamListEnd();
-
-  for (row=0; row<nr_rows_on_board; row++, a_square += onerow)
-  {
-    square curr_square= a_square;
-    for (col=0; col<nr_files_on_board; col++, curr_square += dir_right)
+    for (i = 0; i!=sizeof key; ++i)
     {
-      piece_walk_type const p = get_walk_of_piece_on_square(curr_square);
-      if (p!=Empty)
-        bp = SmallEncodePiece(bp,row,col,p,being_solved.spec[curr_square]);
+      *bp++ = (byte)(key & ByteMask);
+      key >>= CHAR_BIT;
     }
   }
 
@@ -1559,10 +1441,8 @@ static void SmallEncode(stip_length_type min_length,
     square s = (underworld[gi].on
                 - nr_of_slack_rows_below_board*onerow
                 - nr_of_slack_files_left_of_board);
-    row = s/onerow;
-    col = s%onerow;
     bp = SmallEncodePiece(bp,
-                          row,col,
+                          s/onerow,s%onerow,
                           underworld[gi].walk,underworld[gi].flags);
   }
 
@@ -1578,9 +1458,9 @@ static void SmallEncode(stip_length_type min_length,
 
 /* Initialise the bits representing all slices in a hash table
  * element's data field with null values
- * @param he address of hash table element
+ * @param data address of hash table element's data field
  */
-static void init_elements(hashElement_union_t *hue)
+static void init_elements(data_type *data)
 {
   unsigned int i;
 
@@ -1596,13 +1476,13 @@ static void init_elements(hashElement_union_t *hue)
       {
         stip_length_type const length = SLICE_U(si).branch.length;
         stip_length_type const min_length = SLICE_U(si).branch.min_length;
-        set_value_attack_nosuccess(hue,si,0);
-        set_value_attack_success(hue,si,(length-min_length+1)/2);
+        set_value_attack_nosuccess(data,si,0);
+        set_value_attack_success(data,si,(length-min_length+1)/2);
         break;
       }
 
       case STHelpHashed:
-        set_value_help(hue,si,0);
+        set_value_help(data,si,0);
         break;
 
       default:
@@ -1615,45 +1495,363 @@ static void init_elements(hashElement_union_t *hue)
   TraceFunctionResultEnd();
 }
 
-/* (attempt to) allocate a hash table element - compress the current
- * hash table if necessary; exit()s if allocation is not possible
- * in spite of compression
+/* Deallocate the dynamic hash table
+ */
+static void destroy_dht(void)
+{
+#if defined(FXF)
+  /* the table is the only user of fxf; free all of it at once instead of
+   * element by element */
+  fxfReset();
+#else
+  dhtDestroy(pyhash);
+#endif
+  pyhash = 0;
+}
+
+/* (attempt to) allocate a hash table element - evict other elements
+ * if necessary; exit()s if allocation is not possible in spite of eviction
  * @param hb has value (basis for calculation of key)
  * @return address of element
  */
 static dhtElement *allocDHTelement(dhtConstValue hb)
 {
-  dhtElement *result = dhtEnterElement(pyhash,hb,template_element.d.Data);
-  while (result==dhtNilElement)
+  dhtElement *result;
+
+  result = dhtEnterElement(pyhash,hb,template_element.d.Data);
+
+  if (result==dhtNilElement)
   {
-    unsigned long const nrKeysBeforeCompression = dhtKeyCount(pyhash);
-    compresshash();
-    if (dhtKeyCount(pyhash)==nrKeysBeforeCompression)
+    clock_t const start = clock();
+
+    do
     {
-      dhtDestroy(pyhash);
-#if defined(FXF)
-      fxfReset();
-#endif
-      pyhash = dhtCreate(dhtBCMemValue,dhtCopy,dhtSimpleValue,dhtNoCopy);
-      assert(pyhash!=0);
-      result = dhtEnterElement(pyhash,hb,template_element.d.Data);
-      break;
-    }
-    else
-      result = dhtEnterElement(pyhash,hb,template_element.d.Data);
+      if (dhtKeyCount(pyhash)==0)
+      {
+        destroy_dht();
+        pyhash = dhtCreate(dhtBCMemValue,dhtInline,dhtSimpleValue,dhtNoCopy);
+        assert(pyhash!=0);
+        eviction_clock_hand = 0;
+        result = dhtEnterElement(pyhash,hb,template_element.d.Data);
+        break;
+      }
+      else
+      {
+        evict_elements();
+        result = dhtEnterElement(pyhash,hb,template_element.d.Data);
+      }
+    } while (result==dhtNilElement);
+
+    eviction_clock_ticks += clock()-start;
   }
 
   if (result==dhtNilElement)
   {
     fprintf(stderr,
             "Sorry, cannot enter more hashelements "
-            "despite compression\n");
+            "despite eviction\n");
     exit(-2);
   }
 
   return result;
 }
 
+/* Compute the signature of an encoded position for the fixed size table
+ * @param hb encoded position
+ * @return signature
+ */
+static hash_key_type signature_of_encoding(HashBuffer const *hb)
+{
+  /* FNV-1a, followed by a finaliser that makes the lower bits (which are used
+   * for the bucket index) depend on all bytes */
+  hash_key_type result = 0xCBF29CE484222325ULL;
+  /* cmv.Data is declared with length 1, but is followed by the buffer; don't
+   * index it directly, or the compiler will assume that Leng<=1 */
+  byte const *bp = hb->cmv.Data;
+  byte const * const end = bp+hb->cmv.Leng;
+
+  for (; bp!=end; ++bp)
+  {
+    result ^= *bp;
+    result *= 0x100000001B3ULL;
+  }
+
+  result = (result ^ (result>>33)) * 0xFF51AFD7ED558CCDULL;
+  return result ^ (result>>33);
+}
+
+/* data of the position most recently looked up or entered if the fixed size
+ * table is used; that table may be shared with worker processes, so we don't
+ * modify its entries in place */
+static data_type fixed_size_table_data;
+
+/* Look up the current position in the hash table
+ * @param hb encoded position
+ * @return address of the data of the position's element; 0 if there is none
+ * @note if the data is modified, store_data() has to be invoked afterwards
+ */
+static data_type *lookup_data(HashBuffer const *hb)
+{
+  if (is_fixed_size_table_used)
+    return (fixed_hash_table_lookup(signature_of_encoding(hb),
+                                    &fixed_size_table_data)
+            ? &fixed_size_table_data
+            : 0);
+  else
+  {
+    dhtElement * const he = dhtLookupElement(pyhash,hb);
+    if (he==dhtNilElement)
+      return 0;
+    else
+      return &((hashElement_union_t *)he)->e.data;
+  }
+}
+
+/* Update the statistics after a modification of the hash table
+ * @param si identifies the hash slice that has modified the table
+ * @param nr_inserts number of positions inserted
+ * @param nr_evictions number of positions evicted to make room
+ * @param nr_compressions number of compression passes
+ */
+static void count_modification(slice_index si,
+                               unsigned long nr_inserts,
+                               unsigned long nr_evictions,
+                               unsigned long nr_compressions)
+{
+  hash_statistics_type * const slice = slice_statistics+slice_properties[si].hash_slice_index;
+  hash_statistics_type * const ply = ply_statistics+nbply;
+
+  slice->nr_inserts += nr_inserts;
+  slice->nr_evictions += nr_evictions;
+  slice->nr_compressions += nr_compressions;
+
+  ply->nr_inserts += nr_inserts;
+  ply->nr_evictions += nr_evictions;
+  ply->nr_compressions += nr_compressions;
+}
+
+/* Update the statistics after a lookup of the current position
+ * @param si identifies the hash slice that has looked up the position
+ * @param is_hit true iff the lookup has spared solving the position
+ */
+static void count_probe(slice_index si, boolean is_hit)
+{
+  hash_statistics_type * const slice = slice_statistics+slice_properties[si].hash_slice_index;
+  hash_statistics_type * const ply = ply_statistics+nbply;
+
+  ++slice->nr_probes;
+  ++ply->nr_probes;
+
+  if (is_hit)
+  {
+    ++slice->nr_hits;
+    ++ply->nr_hits;
+  }
+}
+
+/* Enter the current position into the hash table
+ * @param si identifies the hash slice entering the position
+ * @param hb encoded position
+ * @return address of the data of the position's (new) element
+ * @note store_data() has to be invoked once the data has been initialised
+ */
+static data_type *enter_data(slice_index si, HashBuffer const *hb)
+{
+  if (is_fixed_size_table_used)
+  {
+    /* the position is inserted (and counted) by store_data() */
+    fixed_size_table_data = template_element.e.data;
+    return &fixed_size_table_data;
+  }
+  else
+  {
+    unsigned long const nr_evicted_before = nr_evicted_elements;
+    unsigned long const nr_compressions_before = nr_compressions;
+    dhtElement * const he = allocDHTelement(hb);
+    count_modification(si,
+                       1,
+                       nr_evicted_elements-nr_evicted_before,
+                       nr_compressions-nr_compressions_before);
+    return &((hashElement_union_t *)he)->e.data;
+  }
+}
+
+/* Write back the data of the current position after it has been modified
+ * @param si identifies the hash slice that has modified the data
+ * @param hb encoded position
+ * @param data address returned by lookup_data() or enter_data()
+ */
+static void store_data(slice_index si,
+                       HashBuffer const *hb,
+                       data_type const *data)
+{
+  if (is_fixed_size_table_used)
+  {
+    unsigned long const nr_replacements = fixed_hash_table_nr_replacements();
+    unsigned long const nr_stored = fixed_hash_table_count();
+    fixed_hash_table_store(signature_of_encoding(hb),*data);
+    {
+      unsigned long const nr_evictions = fixed_hash_table_nr_replacements()-nr_replacements;
+      count_modification(si,
+                         fixed_hash_table_count()-nr_stored+nr_evictions,
+                         nr_evictions,
+                         0);
+      if (nr_evictions!=0)
+        is_table_uncompressed = false;
+    }
+  }
+  /* else: the DHT elements are modified in place */
+}
+
+/* Determine the number of positions currently stored in the hash table
+ * @return number of positions
+ */
+static unsigned long nr_stored_positions(void)
+{
+  if (is_fixed_size_table_used)
+    return fixed_hash_table_count();
+  else
+    return pyhash==0 ? 0 : dhtKeyCount(pyhash);
+}
+
+static void report_statistics(hash_statistics_type const *statistics)
+{
+  unsigned long const hit_permille = (statistics->nr_probes==0
+                                      ? 0
+                                      : (unsigned long)((1000.0*statistics->nr_hits)
+                                                        /statistics->nr_probes));
+  fprintf(stdout," %12lu %12lu %3lu.%lu%% %12lu %12lu %8lu\n",
+          statistics->nr_probes,
+          statistics->nr_hits,
+          hit_permille/10,
+          hit_permille%10,
+          statistics->nr_inserts,
+          statistics->nr_evictions,
+          statistics->nr_compressions);
+}
+
+/* Write the occupancy, fragmentation and failed allocations of the memory of
+ * the dynamic hash table to stdout (if the table is currently set up)
+ */
+static void report_memory_statistics(void)
+{
+#if defined(FXF)
+  if (pyhash!=0)
+    fxfInfo(stdout);
+#endif /*FXF*/
+}
+
+/* Write the statistics about the use of the hash table to stdout
+ */
+void hash_report_statistics(void)
+{
+  hash_statistics_type total = { 0, 0, 0, 0, 0 };
+  unsigned int i;
+  ply p;
+
+  fputs("\nhash table statistics",stdout);
+  if (is_fixed_size_table_used || pyhash!=0)
+    fprintf(stdout,", %lu positions stored",nr_stored_positions());
+  fputs("\n",stdout);
+
+  fprintf(stdout,"%-22s %12s %12s %6s %12s %12s %8s\n",
+          "","probes","hits","","inserts","evictions","compr.");
+
+  for (i = 0; i!=nr_hash_slices; ++i)
+  {
+    slice_index const si = hash_slices[i];
+    hash_statistics_type const * const statistics = slice_statistics+i;
+
+    fprintf(stdout,"%5u %-16s",si,slice_type_names[SLICE_TYPE(si)]);
+    report_statistics(statistics);
+
+    total.nr_probes += statistics->nr_probes;
+    total.nr_hits += statistics->nr_hits;
+    total.nr_inserts += statistics->nr_inserts;
+    total.nr_evictions += statistics->nr_evictions;
+    total.nr_compressions += statistics->nr_compressions;
+  }
+
+  for (p = 0; p<=maxply; ++p)
+  {
+    hash_statistics_type const * const statistics = ply_statistics+p;
+    if (statistics->nr_probes!=0 || statistics->nr_inserts!=0)
+    {
+      fprintf(stdout,"ply %-18u",p);
+      report_statistics(statistics);
+    }
+  }
+
+  fprintf(stdout,"%-22s","total");
+  report_statistics(&total);
+
+  if (!is_fixed_size_table_used)
+    fprintf(stdout,
+            "%lu elements evicted in %.3f seconds since the hash table was"
+            " set up for the current twin\n",
+            nr_evicted_elements,
+            (double)eviction_clock_ticks/CLOCKS_PER_SEC);
+
+  report_memory_statistics();
+
+  fflush(stdout);
+}
+
+/* Reset the statistics about the use of the hash table, e.g. at the start of
+ * a problem
+ */
+void hash_reset_statistics(void)
+{
+  memset(slice_statistics,0,sizeof slice_statistics);
+  memset(ply_statistics,0,sizeof ply_statistics);
+}
+
+/* Determine the total numbers of lookups of positions in the hash table and
+ * of lookups that have spared solving a position since the statistics were
+ * last reset
+ * @param nr_probes where to write the number of lookups
+ * @param nr_hits where to write the number of lookups that have spared solving
+ */
+void hash_get_statistics_total(unsigned long *nr_probes, unsigned long *nr_hits)
+{
+  ply p;
+
+  *nr_probes = 0;
+  *nr_hits = 0;
+
+  for (p = 0; p<=maxply; ++p)
+  {
+    *nr_probes += ply_statistics[p].nr_probes;
+    *nr_hits += ply_statistics[p].nr_hits;
+  }
+}
+
+/* Write the statistics about the use of the hash table to stdout when the
+ * next hash slice is reached
+ * @note to be invoked from a signal handler
+ */
+void hash_schedule_statistics_report(void)
+{
+  is_statistics_report_pending = true;
+}
+
+/* Report the statistics about the use of the hash table at the end of each
+ * problem
+ */
+void hash_request_statistics_report(void)
+{
+  is_statistics_report_requested = true;
+}
+
+/* Write the statistics about the use of the hash table to stdout if this has
+ * been requested for the end of each problem
+ */
+void hash_report_statistics_of_problem(void)
+{
+  if (is_statistics_report_requested)
+    hash_report_statistics();
+}
+
 static unsigned long hashtable_kilos;
 
 /* Allocate memory for the hash table. If the requested amount of
@@ -1664,13 +1862,18 @@ static unsigned long hashtable_kilos;
  */
 unsigned long allochash(unsigned long nr_kilos)
 {
+  if (is_fixed_size_table_used)
+    nr_kilos = fixed_hash_table_allocate(nr_kilos);
+  else
+  {
 #if defined(FXF)
-  size_t const one_kilo = 1<<10;
-  while (fxfInit(nr_kilos*one_kilo)==-1)
-    /* we didn't get hashmemory ... */
-    nr_kilos /= 2;
-  ifTESTHASH(fxfInfo(stdout));
+    size_t const one_kilo = 1<<10;
+    while (fxfInit(nr_kilos*one_kilo)==-1)
+      /* we didn't get hashmemory ... */
+      nr_kilos /= 2;
+    ifTESTHASH(fxfInfo(stdout));
 #endif /*FXF*/
+  }
 
   hashtable_kilos = nr_kilos;
   return nr_kilos;
@@ -1721,7 +1924,18 @@ static boolean is_proofgame(slice_index si)
  */
 boolean is_hashtable_allocated(void)
 {
-  return fxfInitialised();
+  if (is_fixed_size_table_used)
+    return fixed_hash_table_is_allocated();
+  else
+    return fxfInitialised();
+}
+
+/* Use a fixed size table rather than the dynamic one of the DHT module.
+ * To be invoked before allochash().
+ */
+void hash_use_fixed_size_table(void)
+{
+  is_fixed_size_table_used = true;
 }
 
 /* Initialise the hashing machinery for the current stipulation
@@ -1744,11 +1958,16 @@ static void inithash(slice_index si)
 #endif /*__unix,TESTHASH*/
 
   minimalElementValueAfterCompression = 2;
+  eviction_clock_hand = 0;
+  nr_elements_visited_without_eviction = 0;
+  nr_evicted_elements = 0;
+  nr_compressions = 0;
+  eviction_clock_ticks = 0;
 
   init_slice_properties(si);
 
   template_element.d.Data = 0;
-  init_elements(&template_element);
+  init_elements(&template_element.e.data);
 
   is_table_uncompressed = true;     /* V3.60  TLi */
 
@@ -1762,7 +1981,7 @@ static void inithash(slice_index si)
 
   {
     piece_walk_type i;
-    for (i = nr_piece_walks; i>Empty; --i)
+    for (i = nr_piece_walks-1; i>Empty; --i)
       if (piece_walk_may_exist[i])
         piece_nbr[i] = j++;
   }
@@ -1780,6 +1999,10 @@ static void inithash(slice_index si)
 
   bytes_per_piece= one_byte_hash ? 1 : 1+bytes_per_spec;
 
+  /* represent the same flags in the hash key as in the encoding of a piece
+   * (including the piece ids if some condition makes them relevant) */
+  set_hash_key_flags_mask((((Flags)1)<<(CHAR_BIT*bytes_per_spec))-1);
+
   if (is_proofgame(si))
   {
     encode = ProofEncode;
@@ -1788,20 +2011,10 @@ static void inithash(slice_index si)
   }
   else
   {
-    unsigned int const Small = TellSmallEncodePosLeng();
-    unsigned int const Large = TellLargeEncodePosLeng();
-    if (Small<=Large)
-    {
-      encode = SmallEncode;
-      if (hashtable_kilos>0 && hash_max_number_storable_positions==0)
-        hash_max_number_storable_positions= hashtable_kilos/(Small+sizeof(char *)+1);
-    }
-    else
-    {
-      encode = LargeEncode;
-      if (hashtable_kilos>0 && hash_max_number_storable_positions==0)
-        hash_max_number_storable_positions= hashtable_kilos/(Large+sizeof(char *)+1);
-    }
+    unsigned int const Zobrist = TellZobristEncodePosLeng();
+    encode = ZobristEncode;
+    if (hashtable_kilos>0 && hash_max_number_storable_positions==0)
+      hash_max_number_storable_positions= hashtable_kilos/(Zobrist+sizeof(char *)+1);
   }
 
 #if defined(FXF)
@@ -1819,7 +2032,8 @@ static void inithash(slice_index si)
 #endif /*TESTHASH,FXF*/
 
 #if defined(FXF)
-  fxfReset();
+  if (!is_fixed_size_table_used)
+    fxfReset();
 #endif
 
   TraceFunctionExit(__func__);
@@ -1831,9 +2045,28 @@ static void openhash(void)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  assert(pyhash==0);
-  pyhash = dhtCreate(dhtBCMemValue,dhtCopy,dhtSimpleValue,dhtNoCopy);
-  assert(pyhash!=0);
+  if (is_fixed_size_table_used)
+  {
+    /* the workers share the table while solving the same position; a worker
+     * that opens it itself (e.g. for each target position in intelligent mode)
+     * mustn't clear the entries of the others */
+    if (workers_is_worker() && !is_fixed_size_table_unshared)
+    {
+      fixed_hash_table_unshare(workers_get_nr_requested());
+      is_fixed_size_table_unshared = true;
+    }
+
+    fixed_hash_table_clear(&value_of_data);
+  }
+  else
+  {
+    assert(pyhash==0);
+    pyhash = dhtCreate(dhtBCMemValue,dhtInline,dhtSimpleValue,dhtNoCopy);
+    assert(pyhash!=0);
+  }
+
+  /* the board may have been set up or twinned without maintaining the key */
+  recompute_hash_key();
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1846,7 +2079,7 @@ static void closehash(void)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  assert(pyhash!=0);
+  assert(is_fixed_size_table_used || pyhash!=0);
 
 #if defined(TESTHASH)
   fputs("calling closehash\n",stdout);
@@ -1856,6 +2089,9 @@ static void closehash(void)
   if (use_all)
     fprintf(stdout,"Makes %.1f%%\n",(100.0 * use_pos) / use_all);
 #endif
+  fprintf(stdout,"%lu elements evicted in %.3f seconds\n",
+          nr_evicted_elements,
+          (double)eviction_clock_ticks/CLOCKS_PER_SEC);
 #if defined(__unix)
   {
 #if defined(FXF)
@@ -1863,7 +2099,7 @@ static void closehash(void)
 #else
     unsigned long const HashMem = sbrk(0)-OldBreak;
 #endif /*FXF*/
-    unsigned long const HashCount = pyhash==0 ? 0 : dhtKeyCount(pyhash);
+    unsigned long const HashCount = nr_stored_positions();
     if (HashCount>0)
     {
       unsigned long const BytePerPos = (HashMem*100)/HashCount;
@@ -1878,8 +2114,8 @@ static void closehash(void)
 #endif /*__unix*/
 #endif /*TESTHASH*/
 
-  dhtDestroy(pyhash);
-  pyhash = 0;
+  if (!is_fixed_size_table_used)
+    destroy_dht();
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -2070,12 +2306,18 @@ void solving_insert_hashing(slice_index si)
                                     nr_hash_element_inserters);
   stip_traverse_structure(si,&st);
 
+  snapshot_opener = no_slice;
+
   if (!state.opener_inserted)
   {
     slice_index const opener = alloc_pipe(STHashOpener);
     pipe_append(si,opener);
     SLICE_TESTER(opener) = alloc_proxy_slice();
     pipe_append(SLICE_TESTER(si),SLICE_TESTER(opener));
+
+    /* the intelligent mode opens a table per target position; there is
+     * nothing worth saving in those */
+    snapshot_opener = opener;
   }
 
   inithash(si);
@@ -2103,6 +2345,8 @@ void attack_hashed_solve(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
+  hash_deal_with_pending_signals();
+
   assert((SLICE_U(si).branch.length-solve_nr_remaining)%2==0);
 
   pipe_solve_delegate(si);
@@ -2122,31 +2366,36 @@ static void addtohash_battle_nosuccess(slice_index si,
 {
   HashBuffer const * const hb = &hashBuffers[nbply];
   hash_value_type const val = (n+1-min_length_adjusted)/2;
-  dhtElement *he;
+  data_type *data;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParam("%u",min_length_adjusted);
   TraceFunctionParamListEnd();
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
-  {
-    hashElement_union_t * const hue = (hashElement_union_t *)allocDHTelement(hb);
-    set_value_attack_nosuccess(hue,si,val);
-  }
-  else
+  /* solving may have been interrupted below us (e.g. by option maxtime), in
+   * which case we don't know anything about the current position */
+  if (!platform_has_maxtime_elapsed())
   {
-    hashElement_union_t * const hue = (hashElement_union_t *)he;
-    if (get_value_attack_nosuccess(hue,si)<val)
-      set_value_attack_nosuccess(hue,si,val);
+    data = lookup_data(hb);
+    if (data==0)
+    {
+      data = enter_data(si,hb);
+      set_value_attack_nosuccess(data,si,val);
+      store_data(si,hb,data);
+    }
+    else if (get_value_attack_nosuccess(data,si)<val)
+    {
+      set_value_attack_nosuccess(data,si,val);
+      store_data(si,hb,data);
+    }
   }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 
 #if defined(HASHRATE)
-  if (dhtKeyCount(pyhash)%1000 == 0)
+  if (nr_stored_positions()%1000 == 0)
     HashStats(3, "\n");
 #endif /*HASHRATE*/
 }
@@ -2162,32 +2411,34 @@ static void addtohash_battle_success(slice_index si,
 {
   HashBuffer const * const hb = &hashBuffers[nbply];
   hash_value_type const val = (n+1-min_length_adjusted)/2 - 1;
-  dhtElement *he;
+  data_type *data;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParam("%u",min_length_adjusted);
   TraceFunctionParamListEnd();
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
+  if (!platform_has_maxtime_elapsed())
   {
-    hashElement_union_t * const
-        hue = (hashElement_union_t *)allocDHTelement(hb);
-    set_value_attack_success(hue,si,val);
-  }
-  else
-  {
-    hashElement_union_t * const hue = (hashElement_union_t *)he;
-    if (get_value_attack_success(hue,si)>val)
-      set_value_attack_success(hue,si,val);
+    data = lookup_data(hb);
+    if (data==0)
+    {
+      data = enter_data(si,hb);
+      set_value_attack_success(data,si,val);
+      store_data(si,hb,data);
+    }
+    else if (get_value_attack_success(data,si)>val)
+    {
+      set_value_attack_success(data,si,val);
+      store_data(si,hb,data);
+    }
   }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 
 #if defined(HASHRATE)
-  if (dhtKeyCount(pyhash)%1000 == 0)
+  if (nr_stored_positions()%1000 == 0)
     HashStats(3, "\n");
 #endif /*HASHRATE*/
 }
@@ -2234,7 +2485,7 @@ stip_length_type delegate_can_attack_in_n(slice_index si,
  */
 void attack_hashed_tester_solve(slice_index si)
 {
-  dhtElement const *he;
+  data_type const *data;
   slice_index const base = SLICE_U(si).derived_pipe.base;
   stip_length_type const min_length = SLICE_U(base).branch.min_length;
   stip_length_type const played = SLICE_U(base).branch.length-solve_nr_remaining;
@@ -2250,30 +2501,41 @@ void attack_hashed_tester_solve(slice_index si)
 
   assert((solve_nr_remaining-SLICE_U(base).branch.length)%2==0);
 
+  hash_deal_with_pending_signals();
+
   (*encode)(min_length,validity_value);
 
-  he = dhtLookupElement(pyhash,&hashBuffers[nbply]);
-  if (he==dhtNilElement)
+  data = lookup_data(&hashBuffers[nbply]);
+  if (data==0)
+  {
+    count_probe(base,false);
     solve_result = delegate_can_attack_in_n(si,min_length_adjusted);
+  }
   else
   {
-    hashElement_union_t const * const hue = (hashElement_union_t const *)he;
     stip_length_type const parity = (solve_nr_remaining-min_length_adjusted)%2;
 
     /* It is more likely that a position has no solution. */
     /* Therefore let's check for "no solution" first.  TLi */
-    hash_value_type const val_nosuccess = get_value_attack_nosuccess(hue,base);
+    hash_value_type const val_nosuccess = get_value_attack_nosuccess(data,base);
     stip_length_type const n_nosuccess = 2*val_nosuccess + min_length_adjusted-parity;
     if (n_nosuccess>=MOVE_HAS_SOLVED_LENGTH())
+    {
+      count_probe(base,true);
       solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
+    }
     else
     {
-      hash_value_type const val_success = get_value_attack_success(hue,base);
+      hash_value_type const val_success = get_value_attack_success(data,base);
       stip_length_type const n_success = 2*val_success + min_length_adjusted+2-parity;
       if (n_success<=MOVE_HAS_SOLVED_LENGTH())
+      {
+        count_probe(base,true);
         solve_result = n_success;
+      }
       else
       {
+        count_probe(base,false);
         if (max_unsolvable<n_nosuccess)
         {
           max_unsolvable = n_nosuccess;
@@ -2304,7 +2566,7 @@ static boolean inhash_help(slice_index si)
 {
   boolean result;
   HashBuffer *hb = &hashBuffers[nbply];
-  dhtElement const *he;
+  data_type const *data;
   stip_length_type const validity_value = (solve_nr_remaining-1)/2+1;
 
   TraceFunctionEntry(__func__);
@@ -2322,10 +2584,10 @@ static boolean inhash_help(slice_index si)
 
   ifHASHRATE(use_all++);
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
+  data = lookup_data(hb);
+  if (data==0)
     result = false;
-  else if (get_value_help((hashElement_union_t const *)he,si)==1)
+  else if (get_value_help(data,si)==1)
   {
     ifHASHRATE(use_pos++);
     result = true;
@@ -2333,6 +2595,8 @@ static boolean inhash_help(slice_index si)
   else
     result = false;
 
+  count_probe(si,result);
+
   TraceFunctionExit(__func__);
   TraceFunctionResult("%u",result);
   TraceFunctionResultEnd();
@@ -2346,26 +2610,27 @@ static boolean inhash_help(slice_index si)
 static void addtohash_help(slice_index si)
 {
   HashBuffer const * const hb = &hashBuffers[nbply];
-  dhtElement *he;
-  hashElement_union_t * hue;
+  data_type *data;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
-    hue = (hashElement_union_t *)allocDHTelement(hb);
-  else
-    hue = (hashElement_union_t *)he;
+  if (!platform_has_maxtime_elapsed())
+  {
+    data = lookup_data(hb);
+    if (data==0)
+      data = enter_data(si,hb);
 
-  set_value_help(hue,si,1);
+    set_value_help(data,si,1);
+    store_data(si,hb,data);
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 
 #if defined(HASHRATE)
-  if (dhtKeyCount(pyhash)%1000 == 0)
+  if (nr_stored_positions()%1000 == 0)
     HashStats(3, "\n");
 #endif /*HASHRATE*/
 }
@@ -2389,6 +2654,8 @@ void help_hashed_solve(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
+  hash_deal_with_pending_signals();
+
   assert(solve_nr_remaining>=next_move_has_solution);
 
   if (is_table_uncompressed || solve_nr_remaining>next_move_has_solution)
@@ -2438,6 +2705,8 @@ void help_hashed_tester_solve(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
+  hash_deal_with_pending_signals();
+
   assert(solve_nr_remaining>=next_move_has_solution);
 
   if (inhash_help(base))
@@ -2461,6 +2730,336 @@ void help_hashed_tester_solve(slice_index si)
   TraceFunctionResultEnd();
 }
 
+/* The snapshot file starts with a header identifying the problem (cf.
+ * compute_snapshot_fingerprint()), followed by one record per position:
+ * - dynamic table: length and bytes of the encoded position, data
+ * - fixed size table: signature of the encoded position, data
+ * Records are written in the representation of the host; a snapshot is only
+ * meant to be reused on the same machine.
+ */
+enum { snapshot_magic_length = 8 };
+
+static char const snapshot_magic[snapshot_magic_length] = "PYHASH1";
+
+typedef struct
+{
+    char magic[snapshot_magic_length];
+    hash_key_type fingerprint;
+    unsigned long nr_records;
+} snapshot_header_type;
+
+typedef struct
+{
+    FILE *file;
+    unsigned long nr_records;
+} snapshot_writer_type;
+
+static char *snapshot_temporary_file_name;
+
+/* Fold a value into a fingerprint (FNV-1a over the bytes of the value)
+ */
+static hash_key_type fold_into_fingerprint(hash_key_type fingerprint,
+                                           hash_key_type value)
+{
+  unsigned int i;
+
+  for (i = 0; i!=sizeof value; ++i)
+  {
+    fingerprint ^= (value>>(i*CHAR_BIT)) & UCHAR_MAX;
+    fingerprint *= 0x100000001B3ULL;
+  }
+
+  return fingerprint;
+}
+
+/* Compute the fingerprint of the problem about to be solved. The hash table
+ * contents are only meaningful for a problem with the same fingerprint,
+ * i.e. the same position, stipulation, conditions and options, and the same
+ * encoding of positions.
+ */
+static hash_key_type compute_snapshot_fingerprint(void)
+{
+  hash_key_type result = 0xCBF29CE484222325ULL;
+  unsigned int i;
+
+  result = fold_into_fingerprint(result,is_fixed_size_table_used);
+  result = fold_into_fingerprint(result,sizeof(data_type));
+
+  result = fold_into_fingerprint(result,encode==&ProofEncode);
+  result = fold_into_fingerprint(result,one_byte_hash);
+  result = fold_into_fingerprint(result,bytes_per_spec);
+  result = fold_into_fingerprint(result,bytes_per_piece);
+  result = fold_into_fingerprint(result,nr_position_key_words);
+  result = fold_into_fingerprint(result,some_pieces_flags);
+  for (i = 0; i!=nr_piece_walks; ++i)
+    result = fold_into_fingerprint(result,(unsigned char)piece_nbr[i]);
+
+  result = fold_into_fingerprint(result,nr_hash_slices);
+  for (i = 0; i!=nr_hash_slices; ++i)
+  {
+    slice_index const si = hash_slices[i];
+    slice_properties_t const * const props = slice_properties+si;
+
+    result = fold_into_fingerprint(result,si);
+    result = fold_into_fingerprint(result,SLICE_TYPE(si));
+    result = fold_into_fingerprint(result,SLICE_U(si).branch.length);
+    result = fold_into_fingerprint(result,SLICE_U(si).branch.min_length);
+    result = fold_into_fingerprint(result,props->size);
+    result = fold_into_fingerprint(result,props->valueOffset);
+    if (SLICE_TYPE(si)==STHelpHashed)
+    {
+      result = fold_into_fingerprint(result,props->u.h.parity);
+      result = fold_into_fingerprint(result,props->u.h.offsetNoSucc);
+      result = fold_into_fingerprint(result,props->u.h.maskNoSucc);
+    }
+    else
+    {
+      result = fold_into_fingerprint(result,props->u.d.offsetSucc);
+      result = fold_into_fingerprint(result,props->u.d.maskSucc);
+      result = fold_into_fingerprint(result,props->u.d.offsetNoSucc);
+      result = fold_into_fingerprint(result,props->u.d.maskNoSucc);
+    }
+  }
+
+  for (i = 0; i!=CondCount; ++i)
+    result = fold_into_fingerprint(result,CondFlag[i]);
+  for (i = 0; i!=ExtraCondCount; ++i)
+    result = fold_into_fingerprint(result,ExtraCondFlag[i]);
+  for (i = 0; i!=OptCount; ++i)
+    result = fold_into_fingerprint(result,OptFlag[i]);
+
+  for (i = 0; i!=nr_position_key_words; ++i)
+    result = fold_into_fingerprint(result,being_solved.hash_key.word[i]);
+  result = fold_into_fingerprint(result,trait[nbply]);
+  if (encode==&ProofEncode)
+  {
+    position_key_type const target_key = calculate_hash_key(&proofgames_target_position);
+    for (i = 0; i!=nr_position_key_words; ++i)
+      result = fold_into_fingerprint(result,target_key.word[i]);
+  }
+
+  return result;
+}
+
+static void write_snapshot_record_fixed(hash_key_type signature,
+                                        fixed_hash_table_data_type data,
+                                        void *param)
+{
+  snapshot_writer_type * const writer = param;
+
+  fwrite(&signature,sizeof signature,1,writer->file);
+  fwrite(&data,sizeof data,1,writer->file);
+  ++writer->nr_records;
+}
+
+static void write_snapshot_records_dynamic(snapshot_writer_type *writer)
+{
+  dhtElement const *he;
+
+  for (he = dhtGetFirstElement(pyhash);
+       he!=dhtNilElement;
+       he = dhtGetNextElement(pyhash))
+  {
+    hashElement_union_t const * const hue = (hashElement_union_t const *)he;
+    BCMemValue const * const key = (BCMemValue const *)he->Key;
+
+    putc(key->Leng,writer->file);
+    fwrite(key->Data,1,key->Leng,writer->file);
+    fwrite(&hue->e.data,sizeof hue->e.data,1,writer->file);
+    ++writer->nr_records;
+  }
+}
+
+/* Write the hash table to the snapshot file. The file is written under a
+ * temporary name first so that an interrupted write doesn't destroy the
+ * previous snapshot.
+ */
+static void write_snapshot(void)
+{
+  FILE * const file = fopen(snapshot_temporary_file_name,"wb");
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (file!=0)
+  {
+    snapshot_header_type header;
+    snapshot_writer_type writer = { 0, 0 };
+    boolean is_written;
+
+    writer.file = file;
+
+    memset(&header,0,sizeof header);
+    memcpy(header.magic,snapshot_magic,sizeof header.magic);
+    header.fingerprint = snapshot_fingerprint;
+    fwrite(&header,sizeof header,1,file);
+
+    if (is_fixed_size_table_used)
+      fixed_hash_table_visit(&write_snapshot_record_fixed,&writer);
+    else
+      write_snapshot_records_dynamic(&writer);
+
+    header.nr_records = writer.nr_records;
+    fseek(file,0,SEEK_SET);
+    fwrite(&header,sizeof header,1,file);
+
+    is_written = !ferror(file);
+    if (fclose(file)==0 && is_written)
+    {
+      /* rename() doesn't replace an existing file on every platform */
+      remove(snapshot_file_name);
+      rename(snapshot_temporary_file_name,snapshot_file_name);
+    }
+    else
+      remove(snapshot_temporary_file_name);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static boolean read_snapshot_record_fixed(FILE *file)
+{
+  hash_key_type signature;
+  fixed_hash_table_data_type data;
+
+  if (fread(&signature,sizeof signature,1,file)==1
+      && fread(&data,sizeof data,1,file)==1)
+  {
+    unsigned long const nr_replacements = fixed_hash_table_nr_replacements();
+    fixed_hash_table_store(signature,data);
+    if (fixed_hash_table_nr_replacements()!=nr_replacements)
+      is_table_uncompressed = false;
+    return true;
+  }
+  else
+    return false;
+}
+
+static boolean read_snapshot_record_dynamic(FILE *file)
+{
+  HashBuffer hb;
+  data_type data;
+  int const length = getc(file);
+
+  if (length!=EOF
+      && fread(hb.cmv.Data,1,(size_t)length,file)==(size_t)length
+      && fread(&data,sizeof data,1,file)==1)
+  {
+    hb.cmv.Leng = (unsigned char)length;
+    ((hashElement_union_t *)allocDHTelement(&hb))->e.data = data;
+    return true;
+  }
+  else
+    return false;
+}
+
+/* Restore the hash table from the snapshot file if the file exists and was
+ * written while solving the same problem
+ */
+static void read_snapshot(void)
+{
+  FILE * const file = fopen(snapshot_file_name,"rb");
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (file!=0)
+  {
+    snapshot_header_type header;
+
+    if (fread(&header,sizeof header,1,file)==1
+        && memcmp(header.magic,snapshot_magic,sizeof header.magic)==0
+        && header.fingerprint==snapshot_fingerprint)
+    {
+      unsigned long i;
+      for (i = 0; i!=header.nr_records; ++i)
+        if (!(is_fixed_size_table_used
+              ? read_snapshot_record_fixed(file)
+              : read_snapshot_record_dynamic(file)))
+          break;
+    }
+
+    fclose(file);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Options that interrupt solving before the position has been solved
+ * completely make some of the hash table contents unreliable.
+ */
+static boolean is_snapshot_compatible_with_options(void)
+{
+  return !(OptFlag[maxsols] || OptFlag[stoponshort] || OptFlag[restart]);
+}
+
+/* Save the hash table to a file at the end of solving (or when Popeye is
+ * terminated), and restore it from there when the same problem is solved
+ * again.
+ * @param name name of the file
+ */
+void hash_set_snapshot_file(char const *name)
+{
+  size_t const length = strlen(name);
+
+  free(snapshot_temporary_file_name);
+  snapshot_temporary_file_name = malloc(length+sizeof ".tmp");
+  if (snapshot_temporary_file_name==0)
+    snapshot_file_name = 0;
+  else
+  {
+    memcpy(snapshot_temporary_file_name,name,length);
+    memcpy(snapshot_temporary_file_name+length,".tmp",sizeof ".tmp");
+    snapshot_file_name = name;
+  }
+}
+
+/* Terminate Popeye because of a signal. If a snapshot of the hash table is to
+ * be written, termination is deferred until the next hash slice is reached,
+ * where the snapshot is written; otherwise, Popeye terminates immediately.
+ * @param sig number of the signal
+ * @note to be invoked from the signal handler
+ */
+void hash_terminate(int sig)
+{
+  if (is_snapshot_writable)
+    pending_termination_signal = sig;
+  else
+  {
+    output_plaintext_report_aborted(sig);
+    exit(1);
+  }
+}
+
+/* Deal with the signals received since the last invokation: write the
+ * statistics if they have been requested, and write the snapshot and
+ * terminate Popeye if a termination signal was received while the snapshot
+ * was writable.
+ * @note invoked by the hash slices, where the table is consistent
+ */
+void hash_deal_with_pending_signals(void)
+{
+  if (is_statistics_report_pending)
+  {
+    is_statistics_report_pending = false;
+    hash_report_statistics();
+  }
+
+  if (pending_termination_signal!=0)
+  {
+    if (is_snapshot_writable && !workers_is_worker())
+    {
+      is_snapshot_writable = false;
+      write_snapshot();
+    }
+
+    output_plaintext_report_aborted(pending_termination_signal);
+    exit(1);
+  }
+}
+
 /* Try to solve in solve_nr_remaining half-moves.
  * @param si slice index
  * @note assigns solve_result the length of solution found and written, i.e.:
@@ -2481,8 +3080,33 @@ void hash_opener_solve(slice_index si)
   TraceFunctionParamListEnd();
 
   openhash();
+
+  if (si==snapshot_opener
+      && snapshot_file_name!=0
+      && is_snapshot_compatible_with_options())
+  {
+    snapshot_fingerprint = compute_snapshot_fingerprint();
+    read_snapshot();
+    is_snapshot_writable = true;
+  }
+
   pipe_solve_delegate(si);
 
+  if (is_snapshot_writable)
+  {
+    is_snapshot_writable = false;
+    write_snapshot();
+  }
+
+  /* a termination signal may have been received after the last hash slice */
+  hash_deal_with_pending_signals();
+
+  /* closing the table frees its memory, together with the statistics about
+   * it; the tables opened per target position in intelligent mode aren't
+   * reported */
+  if (is_statistics_report_requested && si==snapshot_opener)
+    report_memory_statistics();
+
   closehash();
 
   TraceFunctionExit(__func__);
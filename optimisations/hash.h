@@ -54,6 +54,67 @@ unsigned long allochash(unsigned long nr_kilos);
  */
 boolean is_hashtable_allocated(void);
 
+/* Use a fixed size table rather than the dynamic one of the DHT module.
+ * To be invoked before allochash().
+ */
+void hash_use_fixed_size_table(void);
+
+/* Save the hash table to a file at the end of solving (or when Popeye is
+ * terminated), and restore it from there when the same problem is solved
+ * again.
+ * @param name name of the file
+ */
+void hash_set_snapshot_file(char const *name);
+
+/* Terminate Popeye because of a signal. If a snapshot of the hash table is to
+ * be written, termination is deferred until the next hash slice is reached,
+ * where the snapshot is written; otherwise, Popeye terminates immediately.
+ * @param sig number of the signal
+ * @note to be invoked from the signal handler
+ */
+void hash_terminate(int sig);
+
+/* Deal with the signals received since the last invokation: write the
+ * statistics if they have been requested, and write the snapshot and
+ * terminate Popeye if a termination signal was received while the snapshot
+ * was writable.
+ * @note invoked by the hash slices, where the table is consistent
+ */
+void hash_deal_with_pending_signals(void);
+
+/* Write the statistics about the use of the hash table to stdout
+ */
+void hash_report_statistics(void);
+
+/* Write the statistics about the use of the hash table to stdout when the
+ * next hash slice is reached
+ * @note to be invoked from a signal handler
+ */
+void hash_schedule_statistics_report(void);
+
+/* Reset the statistics about the use of the hash table, e.g. at the start of
+ * a problem
+ */
+void hash_reset_statistics(void);
+
+/* Determine the total numbers of lookups of positions in the hash table and
+ * of lookups that have spared solving a position since the statistics were
+ * last reset
+ * @param nr_probes where to write the number of lookups
+ * @param nr_hits where to write the number of lookups that have spared solving
+ */
+void hash_get_statistics_total(unsigned long *nr_probes, unsigned long *nr_hits);
+
+/* Report the statistics about the use of the hash table at the end of each
+ * problem
+ */
+void hash_request_statistics_report(void);
+
+/* Write the statistics about the use of the hash table to stdout if this has
+ * been requested for the end of each problem
+ */
+void hash_report_statistics_of_problem(void);
+
 void HashStats(unsigned int level, char *trailer);
 
 void IncHashRateLevel(void);
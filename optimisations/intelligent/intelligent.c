@@ -17,6 +17,8 @@
 #include "solving/check.h"
 #include "solving/temporary_hacks.h"
 #include "solving/pipe.h"
+#include "solving/workers.h"
+#include "solving/machinery/slack_length.h"
 #include "stipulation/help_play/branch.h"
 #include "stipulation/fork.h"
 #include "stipulation/pipe.h"
@@ -370,54 +372,132 @@ void solve_target_position(slice_index si)
   TraceFunctionResultEnd();
 }
 
-static void GenerateBlackKing(slice_index si)
+static void place_black_king(slice_index si, square sq_king)
 {
   Flags const king_flags = black[index_of_king].flags;
-  square const *bnp;
 
   TraceFunctionEntry(__func__);
+  TraceSquare(sq_king);
   TraceFunctionParamListEnd();
 
-  assert(black[index_of_king].type==King);
+  if (is_square_empty(sq_king) /* sq_king isn't a hole*/
+      && intelligent_reserve_black_king_moves_from_to(black[index_of_king].diagram_square,
+                                                      sq_king))
+  {
 
-  intelligent_init_reservations(MovesLeft[White],MovesLeft[Black],
-                                MaxPiece[White],MaxPiece[Black]-1);
+    {
+      square s;
+      for (s = 0; s!=maxsquare+4; ++s)
+      {
+        if (nr_reasons_for_staying_empty[s]>0)
+          WriteSquare(&output_plaintext_engine,stdout,s);
+        assert(nr_reasons_for_staying_empty[s]==0);
+      }
+    }
+
+    occupy_square(sq_king,King,king_flags);
+    being_solved.king_square[Black] = sq_king;
+    black[index_of_king].usage = piece_is_king;
 
-  for (bnp = boardnum; *bnp!=initsquare; ++bnp)
-    if (is_square_empty(*bnp) /* *bnp isn't a hole*/
-        && intelligent_reserve_black_king_moves_from_to(black[index_of_king].diagram_square,
-                                                        *bnp))
+    init_guard_dirs(sq_king);
+
+    if (goal_to_be_reached==goal_mate)
     {
+      intelligent_mate_generate_checking_moves(si);
+      intelligent_mate_generate_doublechecking_moves(si);
+    }
+    else
+      pipe_solve_delegate(si);
+
+    empty_square(sq_king);
+
+    intelligent_unreserve();
+  }
 
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Distribute the squares of the black king to worker processes. Two target
+ * positions that lead to the same solution have the black king on the same
+ * square, so each worker can avoid duplicate solutions on its own.
+ * @return true iff the squares have been dealt with by workers
+ */
+static boolean distribute_black_king_squares(slice_index si)
+{
+  boolean result = true;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  switch (workers_distribute(nr_squares_on_board))
+  {
+    case workers_distribution_in_worker:
+    {
+      square const *bnp;
+      for (bnp = boardnum; *bnp!=initsquare; ++bnp)
       {
-        square s;
-        for (s = 0; s!=maxsquare+4; ++s)
+        unsigned long const task = (unsigned long)(bnp-boardnum);
+        if (workers_claim_task(task))
         {
-          if (nr_reasons_for_staying_empty[s]>0)
-            WriteSquare(&output_plaintext_engine,stdout,s);
-          assert(nr_reasons_for_staying_empty[s]==0);
+          place_black_king(si,*bnp);
+          workers_end_task(task);
         }
       }
 
-      occupy_square(*bnp,King,king_flags);
-      being_solved.king_square[Black] = *bnp;
-      black[index_of_king].usage = piece_is_king;
-
-      init_guard_dirs(*bnp);
+      workers_end_worker(solutions_found
+                         ? MOVE_HAS_SOLVED_LENGTH()
+                         : MOVE_HAS_NOT_SOLVED_LENGTH());
+      break;
+    }
 
-      if (goal_to_be_reached==goal_mate)
+    case workers_distribution_in_parent:
+    {
+      unsigned int i;
+      for (i = 0; i!=workers_get_nr_workers(); ++i)
       {
-        intelligent_mate_generate_checking_moves(si);
-        intelligent_mate_generate_doublechecking_moves(si);
+        stip_length_type const result_worker = workers_get_result(i);
+        if (slack_length<result_worker && result_worker<=MOVE_HAS_SOLVED_LENGTH())
+          solutions_found = true;
       }
-      else
-        pipe_solve_delegate(si);
 
-      empty_square(*bnp);
-
-      intelligent_unreserve();
+      workers_end_distribution();
+      break;
     }
 
+    case workers_distribution_failed:
+      result = false;
+      break;
+
+    default:
+      assert(0);
+      break;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+static void GenerateBlackKing(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  assert(black[index_of_king].type==King);
+
+  intelligent_init_reservations(MovesLeft[White],MovesLeft[Black],
+                                MaxPiece[White],MaxPiece[Black]-1);
+
+  if (!(workers_are_used() && distribute_black_king_squares(si)))
+  {
+    square const *bnp;
+    for (bnp = boardnum; *bnp!=initsquare; ++bnp)
+      place_black_king(si,*bnp);
+  }
+
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
@@ -56,7 +56,7 @@ static void place_any_black_piece_on(slice_index si, square placed_on)
 static boolean exists_redundant_white_piece(slice_index si)
 {
   boolean result = false;
-  square const *bnp;
+  bitboard_type white_pieces = being_solved.bitboards.side[White];
   castling_rights_type const save_castling_flag = being_solved.castling_rights;
 
   TraceFunctionEntry(__func__);
@@ -71,15 +71,15 @@ static boolean exists_redundant_white_piece(slice_index si)
   CLRCASTLINGFLAGMASK(Black,k_cancastle);
 
   /* check for redundant white pieces */
-  for (bnp = boardnum; !result && *bnp!=initsquare; bnp++)
+  for (; !result && white_pieces!=0; white_pieces &= white_pieces-1)
   {
-    square const sq = *bnp;
-    if (TSTFLAG(being_solved.spec[sq],White) && !TSTFLAG(being_solved.spec[sq],Royal))
+    square const sq = bitboard_square(bitboard_lowest_index(white_pieces));
+    if (!TSTFLAG(being_solved.spec[sq],Royal))
     {
       PieceIdType const id = GetPieceId(being_solved.spec[sq]);
       piece_usage const usage = white[PieceId2index[id]].usage;
       TraceValue("%u",PieceId2index[id]);
-      TraceSquare(*bnp);
+      TraceSquare(sq);
       TraceEnumerator(piece_usage,usage);
       TraceEOL();
       if (usage!=piece_intercepts_check_from_guard && usage!=piece_gives_check)
@@ -38,45 +38,43 @@ static boolean mate_isGoalReachable(void)
     if (parent_ply[nbply]==ply_retro_move
         || move_effect_journal[top-1].type==move_effect_disable_castling_right)
     {
-      square const *bnp;
+      bitboard_type pieces = (being_solved.bitboards.side[White]
+                              | being_solved.bitboards.side[Black]);
       MovesRequired[White][nbply] = 0;
       MovesRequired[Black][nbply] = 0;
       OpeningsRequired[nbply] = 0;
-      for (bnp = boardnum; *bnp!=initsquare; bnp++)
+      for (; pieces!=0; pieces &= pieces-1)
       {
-        square const from_square = *bnp;
+        square const from_square = bitboard_square(bitboard_lowest_index(pieces));
         piece_walk_type const from_piece = get_walk_of_piece_on_square(from_square);
-        if (from_piece!=Empty && from_piece!=Invalid)
+        PieceIdType const id = GetPieceId(being_solved.spec[from_square]);
+        if (target_position[id].diagram_square!=initsquare)
         {
-          PieceIdType const id = GetPieceId(being_solved.spec[from_square]);
-          if (target_position[id].diagram_square!=initsquare)
+          Side const from_side = TSTFLAG(being_solved.spec[from_square],White) ? White : Black;
+          if (from_side==White
+              && white[PieceId2index[id]].usage==piece_gives_check
+              && MovesLeft[White]>0)
           {
-            Side const from_side = TSTFLAG(being_solved.spec[from_square],White) ? White : Black;
-            if (from_side==White
-                && white[PieceId2index[id]].usage==piece_gives_check
-                && MovesLeft[White]>0)
-            {
-              square const save_king_square = being_solved.king_square[Black];
-              PieceIdType const id_king = GetPieceId(being_solved.spec[being_solved.king_square[Black]]);
-              being_solved.king_square[Black] = target_position[id_king].diagram_square;
-              MovesRequired[from_side][nbply] += intelligent_count_nr_of_moves_from_to_checking(from_side,
-                                                                                                from_piece,
-                                                                                                from_square,
-                                                                                                target_position[id].type,
-                                                                                                target_position[id].diagram_square);
-              being_solved.king_square[Black] = save_king_square;
-            }
-            else
-              MovesRequired[from_side][nbply] += intelligent_count_nr_of_moves_from_to_no_check(from_side,
-                                                                                                from_piece,
-                                                                                                from_square,
-                                                                                                target_position[id].type,
-                                                                                                target_position[id].diagram_square);
+            square const save_king_square = being_solved.king_square[Black];
+            PieceIdType const id_king = GetPieceId(being_solved.spec[being_solved.king_square[Black]]);
+            being_solved.king_square[Black] = target_position[id_king].diagram_square;
+            MovesRequired[from_side][nbply] += intelligent_count_nr_of_moves_from_to_checking(from_side,
+                                                                                              from_piece,
+                                                                                              from_square,
+                                                                                              target_position[id].type,
+                                                                                              target_position[id].diagram_square);
+            being_solved.king_square[Black] = save_king_square;
           }
-
-          if (nr_reasons_for_staying_empty[from_square]>0)
-            ++OpeningsRequired[nbply];
+          else
+            MovesRequired[from_side][nbply] += intelligent_count_nr_of_moves_from_to_no_check(from_side,
+                                                                                              from_piece,
+                                                                                              from_square,
+                                                                                              target_position[id].type,
+                                                                                              target_position[id].diagram_square);
         }
+
+        if (nr_reasons_for_staying_empty[from_square]>0)
+          ++OpeningsRequired[nbply];
       }
     }
     else
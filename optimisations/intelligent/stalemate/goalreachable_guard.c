@@ -60,25 +60,23 @@ static boolean stalemate_isGoalReachable(void)
     if (parent_ply[nbply]==ply_retro_move
         || move_effect_journal[top-1].type==move_effect_disable_castling_right)
     {
-      square const *bnp;
+      bitboard_type pieces = (being_solved.bitboards.side[White]
+                              | being_solved.bitboards.side[Black]);
       MovesRequired[White][nbply] = 0;
       MovesRequired[Black][nbply] = 0;
-      for (bnp = boardnum; *bnp!=initsquare; bnp++)
+      for (; pieces!=0; pieces &= pieces-1)
       {
-        square const from_square = *bnp;
-        if (!is_square_empty(from_square) && !is_square_blocked(from_square))
+        square const from_square = bitboard_square(bitboard_lowest_index(pieces));
+        PieceIdType const id = GetPieceId(being_solved.spec[from_square]);
+        if (target_position[id].diagram_square!=initsquare)
         {
-          PieceIdType const id = GetPieceId(being_solved.spec[from_square]);
-          if (target_position[id].diagram_square!=initsquare)
-          {
-            Side const from_side = TSTFLAG(being_solved.spec[from_square],White) ? White : Black;
-            piece_walk_type const from_piece = get_walk_of_piece_on_square(from_square);
-            MovesRequired[from_side][nbply] += intelligent_count_nr_of_moves_from_to_no_check(from_side,
-                                                                                              from_piece,
-                                                                                              from_square,
-                                                                                              target_position[id].type,
-                                                                                              target_position[id].diagram_square);
-          }
+          Side const from_side = TSTFLAG(being_solved.spec[from_square],White) ? White : Black;
+          piece_walk_type const from_piece = get_walk_of_piece_on_square(from_square);
+          MovesRequired[from_side][nbply] += intelligent_count_nr_of_moves_from_to_no_check(from_side,
+                                                                                            from_piece,
+                                                                                            from_square,
+                                                                                            target_position[id].type,
+                                                                                            target_position[id].diagram_square);
         }
       }
     }
@@ -4,6 +4,7 @@
 #include "stipulation/branch.h"
 #include "stipulation/battle_play/branch.h"
 #include "optimisations/killer_move/killer_move.h"
+#include "optimisations/killer_move/history.h"
 #include "solving/pipe.h"
 #include "debugging/trace.h"
 
@@ -22,6 +23,8 @@ static void remember_killer_move()
   TraceSquare(killer_moves[nbply].capture);
   TraceEOL();
 
+  history_remember_move();
+
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
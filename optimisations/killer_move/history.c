@@ -0,0 +1,244 @@
+#include "optimisations/killer_move/history.h"
+#include "position/position.h"
+#include "position/bitboard.h"
+#include "solving/move_generator.h"
+#include "solving/move_effect_journal.h"
+#include "solving/machinery/slack_length.h"
+#include "stipulation/pipe.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+#include <limits.h>
+#include <string.h>
+
+typedef unsigned long history_score_type;
+
+enum
+{
+  /* when a score exceeds this, all scores are halved */
+  history_max_score = 1<<30
+};
+
+typedef struct
+{
+    square departure;
+    square arrival;
+} counter_move_type;
+
+/* scores indexed by the side, the walk and the departure and arrival squares
+ * of a move */
+static history_score_type history[nr_sides][nr_bitboard_walks][nr_squares_on_board][nr_squares_on_board];
+
+/* the last move of a side that refuted or solved after the opponent's move
+ * from the first to the second indexed square */
+static counter_move_type counter_moves[nr_sides][nr_squares_on_board][nr_squares_on_board];
+
+/* scores of the moves in the move generation stack while they are sorted */
+static history_score_type scores[toppile+1];
+
+/* Forget the moves remembered so far
+ */
+void history_reset(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  memset(history,0,sizeof history);
+  memset(counter_moves,0,sizeof counter_moves);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void halve_scores(void)
+{
+  Side side;
+
+  for (side = White; side!=nr_sides; ++side)
+  {
+    unsigned int w;
+    for (w = 0; w!=nr_bitboard_walks; ++w)
+    {
+      unsigned int from;
+      for (from = 0; from!=nr_squares_on_board; ++from)
+      {
+        unsigned int to;
+        for (to = 0; to!=nr_squares_on_board; ++to)
+          history[side][w][from][to] /= 2;
+      }
+    }
+  }
+}
+
+static void remember_counter_move(Side side,
+                                  square sq_departure,
+                                  square sq_arrival)
+{
+  ply const parent = parent_ply[nbply];
+
+  if (parent>ply_retro_move && CURRMOVE_OF_PLY(parent)>MOVEBASE_OF_PLY(parent))
+  {
+    move_generation_elmt const answered = move_generation_stack[CURRMOVE_OF_PLY(parent)];
+    square const sq_answered_departure = answered.departure;
+    square const sq_answered_arrival = answered.arrival;
+
+    if (is_on_board(sq_answered_departure) && is_on_board(sq_answered_arrival))
+    {
+      counter_move_type * const counter = &counter_moves[side][bitboard_index(sq_answered_departure)][bitboard_index(sq_answered_arrival)];
+      counter->departure = sq_departure;
+      counter->arrival = sq_arrival;
+    }
+  }
+}
+
+/* Remember the move currently played as one that has refuted or solved
+ */
+void history_remember_move(void)
+{
+  move_effect_journal_index_type const movement = move_effect_journal_base[nbply]+move_effect_journal_index_offset_movement;
+  move_generation_elmt const move = move_generation_stack[CURRMOVE_OF_PLY(nbply)];
+  square const sq_departure = move.departure;
+  square const sq_arrival = move.arrival;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  TraceSquare(sq_departure);
+  TraceSquare(sq_arrival);
+  TraceEOL();
+
+  if (move_effect_journal[movement].type==move_effect_piece_movement
+      && is_bitboard_walk(move_effect_journal[movement].u.piece_movement.moving)
+      && is_on_board(sq_departure) && is_on_board(sq_arrival))
+  {
+    Side const side = trait[nbply];
+    piece_walk_type const walk = move_effect_journal[movement].u.piece_movement.moving;
+    history_score_type * const score = &history[side][walk-bitboard_first_walk][bitboard_index(sq_departure)][bitboard_index(sq_arrival)];
+    history_score_type const remaining = (solve_nr_remaining>slack_length
+                                          ? solve_nr_remaining-slack_length
+                                          : 0);
+
+    /* refutations close to the root are worth more */
+    *score += (remaining+1)*(remaining+1);
+    if (*score>history_max_score)
+      halve_scores();
+
+    remember_counter_move(side,sq_departure,sq_arrival);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Allocate a STHistoryMovePrioriser slice.
+ * @return index of allocated slice
+ */
+slice_index alloc_history_move_prioriser_slice(void)
+{
+  slice_index result;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  result = alloc_pipe(STHistoryMovePrioriser);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+static counter_move_type find_counter_move(Side side)
+{
+  counter_move_type result = { initsquare, initsquare };
+  ply const parent = parent_ply[nbply];
+
+  if (parent>ply_retro_move && CURRMOVE_OF_PLY(parent)>MOVEBASE_OF_PLY(parent))
+  {
+    move_generation_elmt const answered = move_generation_stack[CURRMOVE_OF_PLY(parent)];
+    square const sq_answered_departure = answered.departure;
+    square const sq_answered_arrival = answered.arrival;
+
+    if (is_on_board(sq_answered_departure) && is_on_board(sq_answered_arrival))
+      result = counter_moves[side][bitboard_index(sq_answered_departure)][bitboard_index(sq_answered_arrival)];
+  }
+
+  return result;
+}
+
+static void score_moves(void)
+{
+  Side const side = trait[nbply];
+  counter_move_type const counter = find_counter_move(side);
+  numecoup i;
+
+  for (i = MOVEBASE_OF_PLY(nbply)+1; i<=CURRMOVE_OF_PLY(nbply); ++i)
+  {
+    square const sq_departure = move_generation_stack[i].departure;
+    square const sq_arrival = move_generation_stack[i].arrival;
+
+    if (sq_departure==counter.departure && sq_arrival==counter.arrival)
+      scores[i] = ULONG_MAX;
+    else
+    {
+      piece_walk_type const walk = get_walk_of_piece_on_square(sq_departure);
+      assert(is_bitboard_walk(walk));
+      scores[i] = history[side][walk-bitboard_first_walk][bitboard_index(sq_departure)][bitboard_index(sq_arrival)];
+    }
+  }
+}
+
+/* sort the moves by increasing score, i.e. the move with the highest score
+ * will be tried first; moves with equal scores keep their order */
+static void sort_moves(void)
+{
+  numecoup const base = MOVEBASE_OF_PLY(nbply);
+  numecoup i;
+
+  for (i = base+2; i<=CURRMOVE_OF_PLY(nbply); ++i)
+    if (scores[i-1]>scores[i])
+    {
+      move_generation_elmt const move = move_generation_stack[i];
+      history_score_type const score = scores[i];
+      numecoup j = i;
+
+      do
+      {
+        move_generation_stack[j] = move_generation_stack[j-1];
+        scores[j] = scores[j-1];
+        --j;
+      } while (j>base+1 && scores[j-1]>score);
+
+      move_generation_stack[j] = move;
+      scores[j] = score;
+    }
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void history_move_prioriser_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  score_moves();
+  sort_moves();
+
+  pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,46 @@
+#if !defined(OPTIMISATION_KILLER_MOVE_HISTORY_H)
+#define OPTIMISATION_KILLER_MOVE_HISTORY_H
+
+#include "solving/machinery/solve.h"
+
+/* This module implements the history and counter move heuristics, which
+ * complement the killer move optimisation: the moves that have refuted (or
+ * solved) are remembered across the whole solving process
+ * - in a table indexed by the walk of the moving piece and its departure and
+ *   arrival squares, where they accumulate a score weighted by the remaining
+ *   length
+ * - in a table indexed by the move of the opponent that they have answered
+ * The moves are then tried in the order of decreasing score, the counter move
+ * of the opponent's last move first.
+ * Only moves of the orthodox walks are remembered.
+ */
+
+/* Forget the moves remembered so far
+ */
+void history_reset(void);
+
+/* Remember the move currently played as one that has refuted or solved
+ */
+void history_remember_move(void);
+
+/* Allocate a STHistoryMovePrioriser slice.
+ * @return index of allocated slice
+ */
+slice_index alloc_history_move_prioriser_slice(void);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void history_move_prioriser_solve(slice_index si);
+
+#endif
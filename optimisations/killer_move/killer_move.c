@@ -6,6 +6,9 @@
 #include "optimisations/killer_move/prioriser.h"
 #include "optimisations/killer_move/collector.h"
 #include "optimisations/killer_move/final_defense_move.h"
+#include "optimisations/killer_move/staged_move_generator.h"
+#include "optimisations/killer_move/history.h"
+#include "optimisations/orthodox_legal_moves.h"
 #include "debugging/trace.h"
 
 #include "debugging/assert.h"
@@ -244,6 +247,12 @@ static void substitute_killermove_machinery(slice_index si,
       };
       enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
       attack_branch_insert_slices(si,prototypes,nr_prototypes);
+
+      if (orthodox_legal_moves_are_applicable())
+      {
+        slice_index const prototype = alloc_history_move_prioriser_slice();
+        attack_branch_insert_slices(si,&prototype,1);
+      }
     }
     else if (context==stip_traversal_context_defense)
     {
@@ -254,6 +263,13 @@ static void substitute_killermove_machinery(slice_index si,
       };
       enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
       defense_branch_insert_slices(si,prototypes,nr_prototypes);
+
+      if (orthodox_legal_moves_are_applicable())
+      {
+        slice_index const prototype = alloc_history_move_prioriser_slice();
+        defense_branch_insert_slices(si,&prototype,1);
+        pipe_substitute(si,alloc_staged_move_generator_slice());
+      }
     }
   }
 
@@ -347,6 +363,8 @@ static void optimise_move_generators(slice_index si)
     }
   }
 
+  history_reset();
+
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
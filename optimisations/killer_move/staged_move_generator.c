@@ -0,0 +1,144 @@
+#include "optimisations/killer_move/staged_move_generator.h"
+#include "optimisations/killer_move/killer_move.h"
+#include "position/position.h"
+#include "solving/move_generator.h"
+#include "solving/has_solution_type.h"
+#include "stipulation/pipe.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+#include <string.h>
+
+/* Allocate a STStagedMoveGenerator slice.
+ * @return index of allocated slice
+ */
+slice_index alloc_staged_move_generator_slice(void)
+{
+  slice_index result;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  result = alloc_pipe(STStagedMoveGenerator);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* generate the moves of the pieces other than the killer piece in the order
+ * of STMoveGenerator */
+static void generate_moves_of_non_killer_pieces(square sq_killer)
+{
+  bitboard_type pieces = being_solved.bitboards.side[trait[nbply]];
+
+  TraceFunctionEntry(__func__);
+  TraceSquare(sq_killer);
+  TraceFunctionParamListEnd();
+
+  if (sq_killer!=initsquare)
+    pieces &= ~bitboard_of_square(sq_killer);
+
+  while (pieces!=0)
+  {
+    unsigned int const idx = bitboard_highest_index(pieces);
+    generate_moves_for_piece(bitboard_square(idx));
+    pieces ^= (bitboard_type)1<<idx;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Move the captures to the top of the moves of the current ply, i.e. they are
+ * tried first; the order of the captures and of the non-captures among
+ * themselves is preserved */
+static void priorise_captures(void)
+{
+  numecoup const top = CURRMOVE_OF_PLY(nbply);
+  numecoup new_top = MOVEBASE_OF_PLY(nbply);
+  numecoup nr_captures = 0;
+  numecoup i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  /* the captures are parked above the top of the stack */
+  assert(top+(top-new_top)<toppile);
+
+  for (i = new_top+1; i<=top; ++i)
+    if (is_square_empty(move_generation_stack[i].capture))
+    {
+      ++new_top;
+      move_generation_stack[new_top] = move_generation_stack[i];
+    }
+    else
+    {
+      ++nr_captures;
+      move_generation_stack[top+nr_captures] = move_generation_stack[i];
+    }
+
+  memmove(&move_generation_stack[new_top+1],
+          &move_generation_stack[top+1],
+          nr_captures*sizeof move_generation_stack[0]);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void staged_move_generator_solve(slice_index si)
+{
+  stip_length_type result = immobility_on_next_move;
+  square sq_killer;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  nextply(SLICE_STARTER(si));
+
+  sq_killer = killer_moves[nbply].departure;
+  TraceSquare(sq_killer);
+  TraceEOL();
+
+  if (sq_killer!=initsquare
+      && TSTFLAG(being_solved.spec[sq_killer],trait[nbply]))
+  {
+    generate_moves_for_piece(sq_killer);
+    pipe_solve_delegate(si);
+    result = solve_result;
+  }
+  else
+    sq_killer = initsquare;
+
+  if (result<=MOVE_HAS_SOLVED_LENGTH())
+  {
+    generate_moves_of_non_killer_pieces(sq_killer);
+    priorise_captures();
+    pipe_solve_delegate(si);
+    if (solve_result>result)
+      result = solve_result;
+  }
+
+  finply();
+
+  solve_result = result;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
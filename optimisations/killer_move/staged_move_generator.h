@@ -0,0 +1,33 @@
+#if !defined(OPTIMISATION_KILLER_MOVE_STAGED_MOVE_GENERATOR_H)
+#define OPTIMISATION_KILLER_MOVE_STAGED_MOVE_GENERATOR_H
+
+#include "solving/machinery/solve.h"
+
+/* This module provides a move generator for defenses that are only tested.
+ * The moves are generated and tried in stages: first the moves of the piece
+ * that has made the killer move, then the moves of the other pieces, captures
+ * first. The moves of the other pieces are only generated if the killer piece
+ * can't refute the attack.
+ */
+
+/* Allocate a STStagedMoveGenerator slice.
+ * @return index of allocated slice
+ */
+slice_index alloc_staged_move_generator_slice(void);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void staged_move_generator_solve(slice_index si);
+
+#endif
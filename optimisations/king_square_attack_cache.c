@@ -0,0 +1,104 @@
+#include "optimisations/king_square_attack_cache.h"
+#include "position/position.h"
+#include "position/bitboard.h"
+#include "solving/check.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+#include "debugging/measure.h"
+
+typedef struct
+{
+    square king_square;
+    bitboard_type dependencies;
+    bitboard_type modified;
+    boolean is_in_check;
+} cache_entry_type;
+
+static cache_entry_type cache[nr_sides];
+
+/* the squares whose contents determine whether the king of a side is in check
+ */
+static bitboard_type determine_dependencies(Side side_in_check, square sq_king)
+{
+  unsigned int const idx = bitboard_index(sq_king);
+  bitboard_type const occupied = being_solved.bitboards.occupied;
+
+  return (bitboard_of_square(sq_king)
+          | bitboard_king_attacks[idx]
+          | bitboard_knight_attacks[idx]
+          | bitboard_pawn_attackers[advers(side_in_check)][idx]
+          | bitboard_rook_attacks(idx,occupied)
+          | bitboard_bishop_attacks(idx,occupied));
+}
+
+static void collect_modified_squares(void)
+{
+  bitboard_type const modified = being_solved.bitboards.modified;
+
+  cache[White].modified |= modified;
+  cache[Black].modified |= modified;
+  being_solved.bitboards.modified = 0;
+}
+
+DEFINE_COUNTER(king_square_attack_cache_hit)
+
+/* Determine whether a side is in check
+ * @param si identifies the check tester
+ * @param side_in_check which side?
+ * @return true iff side_in_check is in check according to slice si
+ */
+boolean king_square_attack_cache_is_in_check(slice_index si,
+                                             Side side_in_check)
+{
+  boolean result;
+  square const sq_king = being_solved.king_square[side_in_check];
+  cache_entry_type * const entry = &cache[side_in_check];
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceEnumerator(Side,side_in_check);
+  TraceFunctionParamListEnd();
+
+  collect_modified_squares();
+
+  if (sq_king==initsquare)
+    result = pipe_is_in_check_recursive_delegate(si,side_in_check);
+  else if (entry->king_square==sq_king
+           && (entry->modified&entry->dependencies)==0)
+  {
+    INCREMENT_COUNTER(king_square_attack_cache_hit);
+    result = entry->is_in_check;
+  }
+  else
+  {
+    result = pipe_is_in_check_recursive_delegate(si,side_in_check);
+
+    entry->king_square = sq_king;
+    entry->dependencies = determine_dependencies(side_in_check,sq_king);
+    entry->modified = 0;
+    entry->is_in_check = result;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Instrument check testing with the king square attack cache
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_king_square_attack_cache(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  cache[White].king_square = initsquare;
+  cache[Black].king_square = initsquare;
+
+  solving_instrument_check_testing(si,STKingSquareAttackCache);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,30 @@
+#if !defined(OPTIMISATIONS_KING_SQUARE_ATTACK_CACHE_H)
+#define OPTIMISATIONS_KING_SQUARE_ATTACK_CACHE_H
+
+#include "stipulation/stipulation.h"
+#include "position/side.h"
+#include "utilities/boolean.h"
+
+/* This module implements an optimisation for orthodox play: for each side, we
+ * remember whether its king was found in check together with the squares
+ * whose contents determined the result (the king's square, the squares from
+ * where a leaper could attack it and the lines up to the first piece). As
+ * long as none of these squares is modified, e.g. while the sibling moves of
+ * a ply are tested for self-check, the result is reused instead of testing
+ * the observation of the king square again.
+ */
+
+/* Determine whether a side is in check
+ * @param si identifies the check tester
+ * @param side_in_check which side?
+ * @return true iff side_in_check is in check according to slice si
+ */
+boolean king_square_attack_cache_is_in_check(slice_index si,
+                                             Side side_in_check);
+
+/* Instrument check testing with the king square attack cache
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_king_square_attack_cache(slice_index si);
+
+#endif
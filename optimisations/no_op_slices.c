@@ -0,0 +1,107 @@
+#include "optimisations/no_op_slices.h"
+#include "optimisations/orthodox_legal_moves.h"
+#include "position/position.h"
+#include "pieces/walks/walks.h"
+#include "solving/castling.h"
+#include "stipulation/pipe.h"
+#include "debugging/trace.h"
+#include "debugging/measure.h"
+
+#include "debugging/assert.h"
+
+DEFINE_COUNTER(removed_slice)
+
+static void remove_pipe(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+  pipe_remove(si);
+
+  INCREMENT_COUNTER(removed_slice);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* the castling player forks to a proxy leading to the landing slice of the
+ * move */
+static void remove_castling_player(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  assert(SLICE_TYPE(SLICE_NEXT2(si))==STProxy);
+  dealloc_slice(SLICE_NEXT2(si));
+  pipe_remove(si);
+
+  INCREMENT_COUNTER(removed_slice);
+  INCREMENT_COUNTER(removed_slice);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* In orthodox play, castling rights are only ever lost, and pawns can't
+ * come into being; proof games and A=>B problems are solved from a different
+ * position than the one whose castling rights and pieces we know here.
+ */
+static boolean is_play_orthodox_from_diagram(slice_index si)
+{
+  return (orthodox_legal_moves_are_applicable()
+          && !stip_ends_in(si,goal_proofgame)
+          && !stip_ends_in(si,goal_atob));
+}
+
+static boolean can_a_side_castle(void)
+{
+  return (TSTCASTLINGFLAGMASK(White,castlings)>k_cancastle
+          || TSTCASTLINGFLAGMASK(Black,castlings)>k_cancastle);
+}
+
+static boolean are_there_pawns(void)
+{
+  return (being_solved.number_of_pieces[White][standard_walks[Pawn]]>0
+          || being_solved.number_of_pieces[Black][standard_walks[Pawn]]>0);
+}
+
+/* Remove the slices that can't do anything else than delegating from the
+ * solving machinery
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_remove_no_op_slices(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (is_play_orthodox_from_diagram(si))
+  {
+    stip_structure_traversal st;
+
+    stip_structure_traversal_init(&st,0);
+
+    if (!can_a_side_castle())
+    {
+      stip_structure_traversal_override_single(&st,STCastlingPlayer,&remove_castling_player);
+      stip_structure_traversal_override_single(&st,STCastlingRightsAdjuster,&remove_pipe);
+      stip_structure_traversal_override_single(&st,STCastlingGenerator,&remove_pipe);
+    }
+
+    if (!are_there_pawns())
+    {
+      stip_structure_traversal_override_single(&st,STPawnPromoter,&remove_pipe);
+      stip_structure_traversal_override_single(&st,STEnPassantAdjuster,&remove_pipe);
+    }
+
+    stip_traverse_structure(si,&st);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,21 @@
+#if !defined(OPTIMISATIONS_NO_OP_SLICES_H)
+#define OPTIMISATIONS_NO_OP_SLICES_H
+
+#include "stipulation/stipulation.h"
+
+/* This module implements an optimisation that removes slices from the solving
+ * machinery which cannot do anything else than delegating to their successor
+ * in the problem being solved, e.g. the castling slices if neither side has
+ * any castling right left or the pawn slices if there are no pawns.
+ * Proxy slices are removed separately (cf. proxies_resolve()).
+ * The number of removed slices is reported by the counters writer if
+ * DOMEASURE is #defined.
+ */
+
+/* Remove the slices that can't do anything else than delegating from the
+ * solving machinery
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_remove_no_op_slices(slice_index si);
+
+#endif
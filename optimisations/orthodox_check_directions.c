@@ -1,5 +1,6 @@
 #include "optimisations/orthodox_check_directions.h"
 #include "position/position.h"
+#include "position/bitboard.h"
 #include "solving/pipe.h"
 
 #include "debugging/assert.h"
@@ -56,5 +57,7 @@ static void InitCheckDir(void)
 void check_dir_initialiser_solve(slice_index si)
 {
   InitCheckDir();
+  bitboard_init_attack_tables();
+  vec_init_on_board();
   pipe_solve_delegate(si);
 }
@@ -0,0 +1,386 @@
+#include "optimisations/orthodox_legal_moves.h"
+#include "conditions/conditions.h"
+#include "pieces/pieces.h"
+#include "pieces/walks/pawns/en_passant.h"
+#include "position/position.h"
+#include "position/pieceid.h"
+#include "position/bitboard.h"
+#include "stipulation/pipe.h"
+#include "stipulation/slice_insertion.h"
+#include "solving/move_generator.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+
+/* what we know about the legality of the moves of the current ply */
+static struct
+{
+    Side side;
+    square king_square;
+
+    /* the squares where a move of a piece other than the king has to arrive
+     * to stop a check - the entire board if the king isn't in check, the empty
+     * board in double check */
+    bitboard_type check_mask;
+
+    /* the pinned pieces, and for each of them the squares where it can move */
+    bitboard_type pinned;
+    bitboard_type pin_lines[nr_squares_on_board];
+} legality;
+
+static boolean is_orthogonal(bitboard_dir_type dir)
+{
+  return (dir==bitboard_dir_up || dir==bitboard_dir_right
+          || dir==bitboard_dir_down || dir==bitboard_dir_left);
+}
+
+/* the nearest square in a set of squares lying on a ray from some square */
+static unsigned int nearest_on_ray(bitboard_dir_type dir, bitboard_type squares)
+{
+  return (dir<nr_bitboard_dirs_increasing
+          ? bitboard_lowest_index(squares)
+          : bitboard_highest_index(squares));
+}
+
+/* Find the pieces of a side that would attack a square
+ * @param side attacking side
+ * @param sq_target target square
+ * @param occupied the squares that would be occupied
+ * @param removed the pieces of side that would be removed from the board
+ * @return the squares of the attacking pieces
+ */
+static bitboard_type find_attackers(Side side,
+                                    square sq_target,
+                                    bitboard_type occupied,
+                                    bitboard_type removed)
+{
+  bitboards_type const * const bitboards = &being_solved.bitboards;
+  unsigned int const idx = bitboard_index(sq_target);
+  bitboard_type const queens = bitboard_of_walk(bitboards,side,Queen);
+  bitboard_type result;
+
+  result = ((bitboard_king_attacks[idx]
+             & bitboard_of_walk(bitboards,side,King))
+            | (bitboard_knight_attacks[idx]
+               & bitboard_of_walk(bitboards,side,Knight))
+            | (bitboard_rook_attacks(idx,occupied)
+               & (bitboard_of_walk(bitboards,side,Rook)|queens))
+            | (bitboard_bishop_attacks(idx,occupied)
+               & (bitboard_of_walk(bitboards,side,Bishop)|queens)));
+
+  /* cf. pawn_check_ortho() */
+  if (TSTFLAG(sq_spec[sq_target],
+              side==White ? CapturableByWhPawnSq : CapturableByBlPawnSq))
+    result |= (bitboard_pawn_attackers[side][idx]
+               & bitboard_of_walk(bitboards,side,Pawn));
+
+  return result & ~removed;
+}
+
+/* Determine the pinned pieces of the side at the move and the squares that
+ * stop a check
+ */
+static void determine_legality_masks(void)
+{
+  Side const side = trait[nbply];
+  Side const opponent = advers(side);
+  square const sq_king = being_solved.king_square[side];
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  legality.side = side;
+  legality.king_square = sq_king;
+  legality.check_mask = ~(bitboard_type)0;
+  legality.pinned = 0;
+
+  if (sq_king!=initsquare)
+  {
+    bitboards_type const * const bitboards = &being_solved.bitboards;
+    unsigned int const idx_king = bitboard_index(sq_king);
+    bitboard_type const queens = bitboard_of_walk(bitboards,opponent,Queen);
+    bitboard_type const rook_likes = bitboard_of_walk(bitboards,opponent,Rook)|queens;
+    bitboard_type const bishop_likes = bitboard_of_walk(bitboards,opponent,Bishop)|queens;
+    bitboard_type const checkers = find_attackers(opponent,
+                                                  sq_king,
+                                                  bitboards->occupied,
+                                                  0);
+    bitboard_dir_type dir;
+
+    if (checkers!=0)
+    {
+      if ((checkers&(checkers-1))!=0)
+        legality.check_mask = 0;
+      else
+        legality.check_mask = checkers;
+    }
+
+    for (dir = 0; dir!=nr_bitboard_dirs; ++dir)
+    {
+      bitboard_type const ray = bitboard_rays[dir][idx_king];
+      bitboard_type const pieces_on_ray = ray & bitboards->occupied;
+
+      if (pieces_on_ray!=0)
+      {
+        bitboard_type const sliders = is_orthogonal(dir) ? rook_likes : bishop_likes;
+        unsigned int const idx_first = nearest_on_ray(dir,pieces_on_ray);
+        bitboard_type const first = ((bitboard_type)1)<<idx_first;
+
+        if ((first&checkers)!=0)
+        {
+          /* the check can also be stopped on the squares in between */
+          if (legality.check_mask==checkers)
+            legality.check_mask = ray & ~bitboard_rays[dir][idx_first];
+        }
+        else if ((first&bitboards->side[side])!=0)
+        {
+          bitboard_type const behind = pieces_on_ray & bitboard_rays[dir][idx_first];
+          if (behind!=0)
+          {
+            unsigned int const idx_second = nearest_on_ray(dir,behind);
+            if ((sliders&(((bitboard_type)1)<<idx_second))!=0)
+            {
+              legality.pinned |= first;
+              legality.pin_lines[idx_first] = ray & ~bitboard_rays[dir][idx_second];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine whether the king of the side at the move would be attacked after
+ * a move
+ * @param sq_king where the king would be
+ * @param occupied the squares that would be occupied
+ * @param removed the opponent's pieces that would be captured
+ */
+static boolean would_king_be_attacked(square sq_king,
+                                      bitboard_type occupied,
+                                      bitboard_type removed)
+{
+  return find_attackers(advers(legality.side),sq_king,occupied,removed)!=0;
+}
+
+static boolean is_king_move_legal(move_generation_elmt const *move)
+{
+  square const sq_arrival = move->arrival;
+  bitboard_type occupied = (being_solved.bitboards.occupied
+                            & ~bitboard_of_square(move->departure));
+
+  if (move->capture==kingside_castling)
+  {
+    occupied &= ~bitboard_of_square(sq_arrival+dir_right);
+    occupied |= bitboard_of_square(sq_arrival+dir_left);
+  }
+  else if (move->capture==queenside_castling)
+  {
+    occupied &= ~bitboard_of_square(sq_arrival+2*dir_left);
+    occupied |= bitboard_of_square(sq_arrival+dir_right);
+  }
+
+  /* a piece captured on the arrival square doesn't attack that square */
+  return !would_king_be_attacked(sq_arrival,occupied,0);
+}
+
+static boolean is_en_passant_capture_legal(move_generation_elmt const *move)
+{
+  bitboard_type const departure = bitboard_of_square(move->departure);
+  bitboard_type const arrival = bitboard_of_square(move->arrival);
+  bitboard_type const capturee = bitboard_of_square(move->capture-offset_en_passant_capture);
+  bitboard_type const occupied = ((being_solved.bitboards.occupied
+                                   & ~departure & ~capturee)
+                                  | arrival);
+
+  /* the capture may uncover a check along the rank of the two pawns */
+  return !would_king_be_attacked(legality.king_square,occupied,capturee);
+}
+
+static boolean is_move_legal(numecoup n)
+{
+  move_generation_elmt const * const move = move_generation_stack+n;
+  boolean result;
+
+  if (legality.king_square==initsquare)
+    result = true;
+  else if (move->departure==legality.king_square)
+    result = is_king_move_legal(move);
+  else if (en_passant_is_ep_capture(move->capture))
+    result = is_en_passant_capture_legal(move);
+  else
+  {
+    unsigned int const idx_departure = bitboard_index(move->departure);
+    bitboard_type const arrival = bitboard_of_square(move->arrival);
+
+    result = ((legality.check_mask&arrival)!=0
+              && ((legality.pinned&(((bitboard_type)1)<<idx_departure))==0
+                  || (legality.pin_lines[idx_departure]&arrival)!=0));
+  }
+
+  return result;
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void orthodox_remove_illegal_moves_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  determine_legality_masks();
+  move_generator_filter_moves(MOVEBASE_OF_PLY(nbply),&is_move_legal);
+
+  pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine whether the optimisation can be applied, i.e. whether play is
+ * entirely orthodox
+ * @return true iff there are no conditions, fairy pieces or piece attributes
+ */
+boolean orthodox_legal_moves_are_applicable(void)
+{
+  boolean result = true;
+  unsigned int i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  /* noiprom is set whenever there are no imitators */
+  for (i = 0; i!=CondCount; ++i)
+    if (CondFlag[i] && i!=noiprom)
+      result = false;
+
+  for (i = 0; i!=ExtraCondCount; ++i)
+    if (ExtraCondFlag[i])
+      result = false;
+
+  if (piece_walk_may_exist_fairy
+      || (some_pieces_flags&~PieceIdMask)!=0
+      || royal_square[White]!=initsquare
+      || royal_square[Black]!=initsquare)
+    result = false;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+typedef struct
+{
+    Side immobilised;
+} immobility_tester_instrumentation_state_type;
+
+static void instrument_tester(slice_index si, stip_structure_traversal *st)
+{
+  immobility_tester_instrumentation_state_type * const state = st->param;
+  Side const save_immobilised = state->immobilised;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  state->immobilised = SLICE_STARTER(si);
+  stip_traverse_structure_children_pipe(si,st);
+  state->immobilised = save_immobilised;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_remover(slice_index si, stip_structure_traversal *st)
+{
+  immobility_tester_instrumentation_state_type const * const state = st->param;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  if (state->immobilised!=no_side)
+  {
+    slice_index const prototype = alloc_pipe(STOrthodoxRemoveIllegalMoves);
+    slice_insertion_insert_contextually(si,st->context,&prototype,1);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void remove_guard(slice_index si, stip_structure_traversal *st)
+{
+  immobility_tester_instrumentation_state_type const * const state = st->param;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  /* the guard tests whether the immobilised side has exposed its king */
+  if (state->immobilised!=no_side
+      && advers(SLICE_STARTER(si))==state->immobilised)
+    pipe_remove(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static structure_traversers_visitor const immobility_tester_instrumenters[] =
+{
+  { STImmobilityTester,    &instrument_tester },
+  { STDoneGeneratingMoves, &insert_remover    },
+  { STSelfCheckGuard,      &remove_guard      }
+};
+
+enum
+{
+  nr_immobility_tester_instrumenters = (sizeof immobility_tester_instrumenters
+                                        / sizeof immobility_tester_instrumenters[0])
+};
+
+/* Optimise the immobility testers: only legal moves are generated, and the
+ * selfcheck guards are removed from their branches
+ * @param si identifies the root slice of the solving machinery
+ */
+void immobility_testers_generate_orthodox_legal_moves(slice_index si)
+{
+  stip_structure_traversal st;
+  immobility_tester_instrumentation_state_type state = { no_side };
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  TraceStipulation(si);
+
+  stip_structure_traversal_init(&st,&state);
+  stip_structure_traversal_override(&st,
+                                    immobility_tester_instrumenters,
+                                    nr_immobility_tester_instrumenters);
+  stip_traverse_structure(si,&st);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,41 @@
+#if !defined(OPTIMISATIONS_ORTHODOX_LEGAL_MOVES_H)
+#define OPTIMISATIONS_ORTHODOX_LEGAL_MOVES_H
+
+#include "stipulation/stipulation.h"
+#include "utilities/boolean.h"
+
+/* This module implements an optimisation for orthodox play: the moves that
+ * would leave the own king in check are removed from the generated moves
+ * using the pinned pieces and the squares that stop a check, which are
+ * computed once per ply. Branches whose moves are filtered like this don't
+ * have to play each move and test for self-check.
+ */
+
+/* Determine whether the optimisation can be applied, i.e. whether play is
+ * entirely orthodox
+ * @return true iff there are no conditions, fairy pieces or piece attributes
+ */
+boolean orthodox_legal_moves_are_applicable(void);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void orthodox_remove_illegal_moves_solve(slice_index si);
+
+/* Optimise the immobility testers: only legal moves are generated, and the
+ * selfcheck guards are removed from their branches
+ * @param si identifies the root slice of the solving machinery
+ */
+void immobility_testers_generate_orthodox_legal_moves(slice_index si);
+
+#endif
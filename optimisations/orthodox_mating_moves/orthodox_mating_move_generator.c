@@ -426,65 +426,65 @@ static void bishop(square sq_king, Side side)
 
 static void generate_move_reaching_goal()
 {
-  square square_a = square_a1;
   Side const side_at_move = trait[nbply];
   square const OpponentsKing = side_at_move==White ? being_solved.king_square[Black] : being_solved.king_square[White];
-  int i;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
   if (OpponentsKing!=initsquare)
-    /* Don't try to "optimize" by hand. The double-loop is tested as
-     * the fastest way to compute (due to compiler-optimizations!) */
-    for (i = nr_rows_on_board; i>0; i--, square_a += onerow)
+  {
+    /* visit the pieces from a1 to h8 */
+    bitboard_type pieces = being_solved.bitboards.side[side_at_move];
+
+    while (pieces!=0)
     {
-      int j;
-      curr_generation->departure = square_a;
-      for (j = nr_files_on_board; j>0; j--, curr_generation->departure += dir_right)
+      unsigned int const idx = bitboard_lowest_index(pieces);
+      piece_walk_type p;
+
+      curr_generation->departure = bitboard_square(idx);
+      p = get_walk_of_piece_on_square(curr_generation->departure);
+
+      if (CondFlag[gridchess]
+          && !GridLegal(curr_generation->departure,OpponentsKing))
       {
-        piece_walk_type const p = get_walk_of_piece_on_square(curr_generation->departure);
-        if (p!=Empty && TSTFLAG(being_solved.spec[curr_generation->departure],side_at_move))
+        move_generation_current_walk = p;
+        generate_moves_for_piece_based_on_walk();
+      }
+      else
+        switch (p)
         {
-          if (CondFlag[gridchess]
-              && !GridLegal(curr_generation->departure,OpponentsKing))
-          {
-            move_generation_current_walk = p;
-            generate_moves_for_piece_based_on_walk();
-          }
-          else
-            switch (p)
-            {
-              case King:
-                king(OpponentsKing,side_at_move);
-                break;
-
-              case Pawn:
-                pawn(OpponentsKing,side_at_move);
-                break;
-
-              case Knight:
-                knight(OpponentsKing,side_at_move);
-                break;
-
-              case Rook:
-                rook(OpponentsKing,side_at_move);
-                break;
-
-              case Queen:
-                queen(OpponentsKing,side_at_move);
-                break;
-
-              case Bishop:
-                bishop(OpponentsKing,side_at_move);
-                break;
-
-              default:
-                /* avoid compiler warning */
-                break;
-            }
+          case King:
+            king(OpponentsKing,side_at_move);
+            break;
+
+          case Pawn:
+            pawn(OpponentsKing,side_at_move);
+            break;
+
+          case Knight:
+            knight(OpponentsKing,side_at_move);
+            break;
+
+          case Rook:
+            rook(OpponentsKing,side_at_move);
+            break;
+
+          case Queen:
+            queen(OpponentsKing,side_at_move);
+            break;
+
+          case Bishop:
+            bishop(OpponentsKing,side_at_move);
+            break;
+
+          default:
+            /* avoid compiler warning */
+            break;
         }
-      }
+
+      pieces &= pieces-1;
+    }
   }
 
   TraceFunctionExit(__func__);
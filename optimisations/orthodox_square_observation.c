@@ -2,36 +2,10 @@
 #include "solving/find_square_observer_tracking_back_from_target.h"
 #include "pieces/walks/pawns/en_passant.h"
 #include "position/position.h"
+#include "position/bitboard.h"
 #include "debugging/trace.h"
 #include "pieces/pieces.h"
 
-static boolean leapers_check_ortho(Side side_checking,
-                                   square sq_king,
-                                   vec_index_type kanf, vec_index_type kend,
-                                   piece_walk_type p)
-{
-  vec_index_type k;
-  for (k = kanf; k<=kend; k++)
-  {
-    square const sq_departure = sq_king+vec[k];
-    if (get_walk_of_piece_on_square(sq_departure)==p
-        && TSTFLAG(being_solved.spec[sq_departure],side_checking))
-      return true;
-  }
-
-  return false;
-}
-
-static boolean king_check_ortho(Side side_checking, square sq_king)
-{
-  return leapers_check_ortho(side_checking,sq_king, vec_queen_start,vec_queen_end, King);
-}
-
-static boolean knight_check_ortho(Side side_checking, square sq_king)
-{
-  return leapers_check_ortho(side_checking,sq_king, vec_knight_start,vec_knight_end, Knight);
-}
-
 static boolean pawn_test_check_ortho(Side side_checking, square sq_departure)
 {
   boolean result;
@@ -98,9 +72,8 @@ static boolean pawn_check_ortho(Side side_checking, square sq_king)
     numvec const dir_forward_right = dir_forward+dir_right;
     numvec const dir_forward_left = dir_forward+dir_left;
 
-    if (pawn_test_check_ortho(side_checking,sq_king-dir_forward_right))
-      result = true;
-    else if (pawn_test_check_ortho(side_checking,sq_king-dir_forward_left))
+    if ((bitboard_pawn_attackers[side_checking][bitboard_index(sq_king)]
+         & bitboard_of_walk(&being_solved.bitboards,side_checking,Pawn))!=0)
       result = true;
     else if (en_passant_test_check_ortho(side_checking,sq_king,dir_forward_right))
       result = true;
@@ -117,40 +90,35 @@ static boolean pawn_check_ortho(Side side_checking, square sq_king)
 boolean is_square_observed_ortho(Side side_checking,
                                  square sq_target)
 {
-  if (being_solved.number_of_pieces[side_checking][King]>0
-      && king_check_ortho(side_checking,sq_target))
-    return true;
+  /* the orthodox pieces are tested using the bitboards */
+  if (is_on_board(sq_target))
+  {
+    bitboards_type const * const bitboards = &being_solved.bitboards;
+    unsigned int const idx = bitboard_index(sq_target);
 
-  if (being_solved.number_of_pieces[side_checking][Pawn]>0
-      && pawn_check_ortho(side_checking,sq_target))
-    return true;
+    if ((bitboard_king_attacks[idx]
+         & bitboard_of_walk(bitboards,side_checking,King))!=0)
+      return true;
 
-  if (being_solved.number_of_pieces[side_checking][Knight]>0
-      && knight_check_ortho(side_checking,sq_target))
-    return true;
+    if (bitboard_of_walk(bitboards,side_checking,Pawn)!=0
+        && pawn_check_ortho(side_checking,sq_target))
+      return true;
+
+    if ((bitboard_knight_attacks[idx]
+         & bitboard_of_walk(bitboards,side_checking,Knight))!=0)
+      return true;
 
-  if (being_solved.number_of_pieces[side_checking][Queen]>0
-      || being_solved.number_of_pieces[side_checking][Rook]>0)
-  {
-    vec_index_type k;
-    for (k= vec_rook_end; k>=vec_rook_start; k--)
     {
-      square const sq_departure = find_end_of_line(sq_target,vec[k]);
-      piece_walk_type const p = get_walk_of_piece_on_square(sq_departure);
-      if ((p==Rook || p==Queen) && TSTFLAG(being_solved.spec[sq_departure],side_checking))
+      bitboard_type const queens = bitboard_of_walk(bitboards,side_checking,Queen);
+      bitboard_type const rooks = bitboard_of_walk(bitboards,side_checking,Rook);
+      bitboard_type const bishops = bitboard_of_walk(bitboards,side_checking,Bishop);
+
+      if ((rooks|queens)!=0
+          && (bitboard_rook_attacks(idx,bitboards->occupied)&(rooks|queens))!=0)
         return true;
-    }
-  }
 
-  if (being_solved.number_of_pieces[side_checking][Queen]>0
-      || being_solved.number_of_pieces[side_checking][Bishop]>0)
-  {
-    vec_index_type k;
-    for (k= vec_bishop_start; k<=vec_bishop_end; k++)
-    {
-      square const sq_departure = find_end_of_line(sq_target,vec[k]);
-      piece_walk_type const p = get_walk_of_piece_on_square(sq_departure);
-      if ((p==Bishop || p==Queen) && TSTFLAG(being_solved.spec[sq_departure],side_checking))
+      if ((bishops|queens)!=0
+          && (bitboard_bishop_attacks(idx,bitboards->occupied)&(bishops|queens))!=0)
         return true;
     }
   }
@@ -172,24 +140,32 @@ boolean is_square_observed_ortho(Side side_checking,
 
 boolean is_square_uninterceptably_observed_ortho(Side side_checking, square sq_target)
 {
-  if (being_solved.number_of_pieces[side_checking][Pawn]>0
+  bitboards_type const * const bitboards = &being_solved.bitboards;
+  unsigned int idx;
+
+  if (!is_on_board(sq_target))
+    return false;
+
+  idx = bitboard_index(sq_target);
+
+  if (bitboard_of_walk(bitboards,side_checking,Pawn)!=0
       && pawn_check_ortho(side_checking,sq_target))
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Knight]>0
-      && knight_check_ortho(side_checking,sq_target))
+  if ((bitboard_knight_attacks[idx]
+       & bitboard_of_walk(bitboards,side_checking,Knight))!=0)
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Rook]>0
-      && leapers_check_ortho(side_checking,sq_target, vec_rook_start,vec_rook_end, Rook))
+  if ((bitboard_rook_neighbours[idx]
+       & bitboard_of_walk(bitboards,side_checking,Rook))!=0)
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Bishop]>0
-      && leapers_check_ortho(side_checking,sq_target, vec_bishop_start,vec_bishop_end, Bishop))
+  if ((bitboard_bishop_neighbours[idx]
+       & bitboard_of_walk(bitboards,side_checking,Bishop))!=0)
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Queen]>0
-      && leapers_check_ortho(side_checking,sq_target, vec_queen_start,vec_queen_end, Queen))
+  if ((bitboard_king_attacks[idx]
+       & bitboard_of_walk(bitboards,side_checking,Queen))!=0)
     return true;
 
   return false;
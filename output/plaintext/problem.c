@@ -8,6 +8,8 @@
 #include "stipulation/branch.h"
 #include "stipulation/slice_insertion.h"
 #include "solving/incomplete.h"
+#include "optimisations/hash.h"
+#include "debugging/statistics.h"
 #include "debugging/assert.h"
 
 /* Try to solve in solve_nr_remaining half-moves.
@@ -41,6 +43,9 @@ void output_plaintext_problem_writer_solve(slice_index si)
     slice_insertion_insert(si,prototypes,nr_prototypes);
   }
 
+  hash_reset_statistics();
+  statistics_reset();
+
   pipe_solve_delegate(si);
 
   {
@@ -77,6 +82,9 @@ void output_plaintext_problem_writer_solve(slice_index si)
   output_plaintext_message(NewLine);
   protocol_fflush(stdout);
 
+  hash_report_statistics_of_problem();
+  statistics_report_of_problem();
+
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
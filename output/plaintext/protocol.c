@@ -33,6 +33,14 @@ FILE *protocol_open(char const *filename)
   return TraceFile;
 }
 
+/* Stop writing to the protocol file (if any) without closing it, e.g. in a
+ * worker process whose output is written to the protocol by the parent process
+ */
+void protocol_detach(void)
+{
+  TraceFile = 0;
+}
+
 /* like putchar().
  * If a trace file is active, output goes to the trace file as well
  * @return the result of writing to *regular
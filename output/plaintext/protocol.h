@@ -19,6 +19,11 @@ void protocol_overwrite(void);
  */
 FILE *protocol_open(char const *filename);
 
+/* Stop writing to the protocol file (if any) without closing it, e.g. in a
+ * worker process whose output is written to the protocol by the parent process
+ */
+void protocol_detach(void);
+
 /* like putchar().
  * If a trace file is active, output goes to the trace file as well
  * @return the result of writing to *regular
@@ -1,30 +1,113 @@
 #include "pieces/walks/leapers.h"
 #include "solving/move_generator.h"
 #include "solving/fork.h"
+#include "position/bitboard.h"
 #include "debugging/trace.h"
 
+#include "debugging/assert.h"
+#include <limits.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+/* the gather instructions below read being_solved.spec as an array of
+ * unsigned long; Flags is 4 bytes wide on LLP64 platforms (e.g. Windows) and
+ * 8 bytes wide on LP64 ones */
+typedef char flags_are_unsigned_long[sizeof(Flags)==sizeof(unsigned long) ? 1 : -1];
+#endif
+
 /* Generate moves for a leaper piece
  * @param kbeg start of range of vector indices to be used
  * @param kend end of range of vector indices to be used
  */
 void leaper_generate_moves(vec_index_type kbeg, vec_index_type kend)
 {
-  /* generate leaper moves from vec[kbeg] to vec[kend] */
-  vec_index_type k;
+  /* generate leaper moves from vec[kbeg] to vec[kend], skipping the vectors
+   * that leave the board */
+  vec_set_word_type targets = vec_on_board_in_range(curr_generation->departure,
+                                                    kbeg,kend);
 
-  for (k= kbeg; k<= kend; ++k)
+  while (targets!=0)
   {
+    vec_index_type const k = kbeg+(vec_index_type)bitboard_lowest_index(targets);
     curr_generation->arrival = curr_generation->departure+vec[k];
     if (is_square_empty(curr_generation->arrival)
         || piece_belongs_to_opponent(curr_generation->arrival))
       push_move();
+    targets &= targets-1;
   }
 }
 
+/* bit k-kanf is set iff vec[k] leads to a candidate observer */
+typedef unsigned long long leaper_candidates_type;
+
+/* Determine the squares from where a leaper of the side at the move might
+ * observe a square. Most of these squares are empty or occupied by the
+ * opponent, so checking the side for all of them at once saves us from
+ * stepping through the vectors one by one and mispredicting a branch for
+ * each of them.
+ * If AVX2 is available, the flags of 4 squares are gathered and tested at a
+ * time.
+ * @param sq_target the observed square
+ * @param kanf start of range of vector indices to be used
+ * @param kend end of range of vector indices to be used
+ * @return candidates
+ */
+static leaper_candidates_type find_candidates(square sq_target,
+                                              vec_index_type kanf,
+                                              vec_index_type kend)
+{
+  Flags const side_mask = BIT(trait[nbply]);
+  leaper_candidates_type result = 0;
+  vec_index_type k = kanf;
+
+  assert(kend-kanf<(vec_index_type)(sizeof result*CHAR_BIT));
+
+#if defined(__AVX2__)
+  {
+    __m128i const targets = _mm_set1_epi32(sq_target);
+#if ULONG_MAX>0xffffffffUL
+    __m256i const side_masks = _mm256_set1_epi64x((long long)side_mask);
+#else
+    __m128i const side_masks = _mm_set1_epi32((int)side_mask);
+#endif
+
+    for (; k+3<=kend; k += 4)
+    {
+      __m128i const vectors = _mm_loadu_si128((__m128i const *)&vec[k]);
+      __m128i const departures = _mm_add_epi32(targets,vectors);
+#if ULONG_MAX>0xffffffffUL
+      __m256i const specs = _mm256_i32gather_epi64((long long const *)being_solved.spec,
+                                                   departures,
+                                                   sizeof being_solved.spec[0]);
+      __m256i const sides = _mm256_and_si256(specs,side_masks);
+      __m256i const others = _mm256_cmpeq_epi64(sides,_mm256_setzero_si256());
+      unsigned int const other_bits = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(others));
+#else
+      __m128i const specs = _mm_i32gather_epi32((int const *)being_solved.spec,
+                                                departures,
+                                                sizeof being_solved.spec[0]);
+      __m128i const sides = _mm_and_si128(specs,side_masks);
+      __m128i const others = _mm_cmpeq_epi32(sides,_mm_setzero_si128());
+      unsigned int const other_bits = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(others));
+#endif
+      result |= (leaper_candidates_type)(~other_bits & 0xf) << (k-kanf);
+    }
+  }
+#endif
+
+  for (; k<=kend; ++k)
+    if (being_solved.spec[sq_target+vec[k]] & side_mask)
+      result |= (leaper_candidates_type)1 << (k-kanf);
+
+  return result;
+}
+
 boolean leapers_check(vec_index_type kanf, vec_index_type kend,
                       validator_id evaluate)
 {
   square const sq_target = move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture;
+  leaper_candidates_type candidates = find_candidates(sq_target,kanf,kend);
   boolean result = false;
 
   TraceFunctionEntry(__func__);
@@ -35,16 +118,17 @@ boolean leapers_check(vec_index_type kanf, vec_index_type kend,
 
   ++observation_context;
 
-  for (interceptable_observation[observation_context].vector_index1 = kanf;
-       interceptable_observation[observation_context].vector_index1<=kend;
-       interceptable_observation[observation_context].vector_index1++)
+  while (candidates!=0)
   {
-    square const sq_departure= sq_target+vec[interceptable_observation[observation_context].vector_index1];
+    vec_index_type const k = kanf+(vec_index_type)bitboard_lowest_index(candidates);
+    square const sq_departure = sq_target+vec[k];
+    interceptable_observation[observation_context].vector_index1 = k;
     if (EVALUATE_OBSERVATION(evaluate,sq_departure,sq_target))
     {
       result = true;
       break;
     }
+    candidates &= candidates-1;
   }
 
   --observation_context;
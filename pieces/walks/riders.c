@@ -2,6 +2,7 @@
 #include "solving/move_generator.h"
 #include "solving/observation.h"
 #include "solving/fork.h"
+#include "position/bitboard.h"
 #include "debugging/trace.h"
 
 /* Generate moves to the square on a line segment
@@ -34,25 +35,75 @@ square generate_moves_on_line_segment(square sq_base, vec_index_type k)
  */
 void rider_generate_moves(vec_index_type kbeg, vec_index_type kend)
 {
-  /* generate rider moves from vec[kbeg] to vec[kend] */
-  vec_index_type k;
+  /* generate rider moves from vec[kbeg] to vec[kend], skipping the lines
+   * that leave the board immediately */
+  vec_set_word_type lines;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",kbeg);
   TraceFunctionParam("%u",kend);
   TraceFunctionParamListEnd();
 
-  for (k = kbeg; k<=kend; ++k)
+  lines = vec_on_board_in_range(curr_generation->departure,kbeg,kend);
+
+  while (lines!=0)
   {
+    vec_index_type const k = kbeg+(vec_index_type)bitboard_lowest_index(lines);
     curr_generation->arrival = generate_moves_on_line_segment(curr_generation->departure,k);
     if (piece_belongs_to_opponent(curr_generation->arrival))
       push_move();
+    lines &= lines-1;
   }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
 
+/* Determine whether a square is observed by a rider moving along the lines of
+ * queens, using the bitboards to skip the lines where the observer can't be
+ * found
+ * @note has the same side effects as the loop in riders_check()
+ */
+static boolean queen_lines_check(vec_index_type kanf, vec_index_type kend,
+                                 validator_id evaluate,
+                                 square sq_target)
+{
+  bitboards_type const * const bitboards = &being_solved.bitboards;
+  unsigned int const idx = bitboard_index(sq_target);
+  bitboard_type observers = 0;
+  boolean result = false;
+
+  if (kanf<=vec_rook_end)
+    observers |= bitboard_rook_attacks(idx,bitboards->occupied);
+  if (kend>=vec_bishop_start)
+    observers |= bitboard_bishop_attacks(idx,bitboards->occupied);
+
+  /* only the pieces of the observing side can be the observer */
+  observers &= bitboards->side[trait[nbply]];
+
+  if (observers!=0)
+    for (interceptable_observation[observation_context].vector_index1 = kanf;
+         interceptable_observation[observation_context].vector_index1<= kend;
+         ++interceptable_observation[observation_context].vector_index1)
+    {
+      vec_index_type const k = interceptable_observation[observation_context].vector_index1;
+      bitboard_type const observer = observers&bitboard_rays[bitboard_dir_of_vec[k]][idx];
+      if (observer!=0)
+      {
+        square const sq_departure = bitboard_square(bitboard_lowest_index(observer));
+        TraceSquare(sq_departure);
+        TraceEOL();
+        if (EVALUATE_OBSERVATION(evaluate,sq_departure,sq_target))
+        {
+          result = true;
+          break;
+        }
+      }
+    }
+
+  return result;
+}
+
 boolean riders_check(vec_index_type kanf, vec_index_type kend,
                      validator_id evaluate)
 {
@@ -67,19 +118,22 @@ boolean riders_check(vec_index_type kanf, vec_index_type kend,
 
   TraceEnumerator(Side,trait[nbply]);
   TraceEOL();
-  for (interceptable_observation[observation_context].vector_index1 = kanf;
-       interceptable_observation[observation_context].vector_index1<= kend;
-       ++interceptable_observation[observation_context].vector_index1)
-  {
-    square const sq_departure = find_end_of_line(sq_target,vec[interceptable_observation[observation_context].vector_index1]);
-    TraceSquare(sq_departure);
-    TraceEOL();
-    if (EVALUATE_OBSERVATION(evaluate,sq_departure,sq_target))
+  if (vec_queen_start<=kanf && kend<=vec_queen_end && is_on_board(sq_target))
+    result = queen_lines_check(kanf,kend,evaluate,sq_target);
+  else
+    for (interceptable_observation[observation_context].vector_index1 = kanf;
+         interceptable_observation[observation_context].vector_index1<= kend;
+         ++interceptable_observation[observation_context].vector_index1)
     {
-      result = true;
-      break;
+      square const sq_departure = find_end_of_line(sq_target,vec[interceptable_observation[observation_context].vector_index1]);
+      TraceSquare(sq_departure);
+      TraceEOL();
+      if (EVALUATE_OBSERVATION(evaluate,sq_departure,sq_target))
+      {
+        result = true;
+        break;
+      }
     }
-  }
 
   --observation_context;
 
@@ -1,5 +1,7 @@
 #include "pieces/walks/vectors.h"
 #include "position/board.h"
+#include "position/bitboard.h"
+#include "debugging/assert.h"
 
 /* This are the vectors for the CAT (a special concatenation of knight and
  * dabbabba-rider)
@@ -58,3 +60,54 @@ numvec vec[maxvec + 1] = { 0,
 /* 217 - 224 | 6,7 */  137,  162,  174,  151, -137, -162, -174, -151,
 /* 225 - 232 | 2,7 */   41,  166,  170,   55,  -41, -166, -170,  -55,
 };
+
+/* the vectors leading from the indexed square to a square on the board */
+static vec_set_word_type on_board[nr_squares_on_board][nr_vec_set_words];
+
+/* Initialise the sets of vectors that stay on the board
+ */
+void vec_init_on_board(void)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_squares_on_board; ++i)
+  {
+    square const sq = boardnum[i];
+    unsigned int k;
+
+    for (k = 0; k!=nr_vec_set_words; ++k)
+      on_board[i][k] = 0;
+
+    for (k = 1; k<=maxvec; ++k)
+      if (is_on_board(sq+vec[k]))
+        on_board[i][k/vec_set_word_bits] |= (vec_set_word_type)1 << (k%vec_set_word_bits);
+  }
+}
+
+/* Determine the vectors of a range that lead from a square to a square on the
+ * board
+ * @param sq square on the board
+ * @param kbeg start of range of vector indices
+ * @param kend end of range of vector indices; kend-kbeg<vec_set_word_bits
+ * @return bit k-kbeg is set iff sq+vec[k] is on the board
+ */
+vec_set_word_type vec_on_board_in_range(square sq,
+                                        vec_index_type kbeg,
+                                        vec_index_type kend)
+{
+  vec_set_word_type const * const words = on_board[bitboard_index(sq)];
+  unsigned int const word = kbeg/vec_set_word_bits;
+  unsigned int const offset = kbeg%vec_set_word_bits;
+  unsigned int const nr_vectors = kend-kbeg+1;
+  vec_set_word_type result = words[word]>>offset;
+
+  assert(nr_vectors<=vec_set_word_bits);
+
+  if (offset!=0 && word+1<nr_vec_set_words)
+    result |= words[word+1] << (vec_set_word_bits-offset);
+
+  if (nr_vectors<vec_set_word_bits)
+    result &= ((vec_set_word_type)1<<nr_vectors)-1;
+
+  return result;
+}
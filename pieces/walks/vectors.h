@@ -1,6 +1,8 @@
 #if !defined(PIECES_WALKS_VECTORS_H)
 #define PIECES_WALKS_VECTORS_H
 
+#include "position/board.h"
+
 typedef int numvec;
 
 extern numvec const cat_vectors[17];
@@ -61,5 +63,30 @@ typedef enum
   vec_leap27_start=225,           vec_leap27_end=  232
 } vec_index_type;
 
+/* Sets of vector indices: bit k%vec_set_word_bits of word
+ * k/vec_set_word_bits represents vec[k]
+ */
+typedef unsigned long long vec_set_word_type;
+
+enum
+{
+  vec_set_word_bits = 64,
+  nr_vec_set_words = maxvec/vec_set_word_bits+1
+};
+
+/* Initialise the sets of vectors that stay on the board
+ */
+void vec_init_on_board(void);
+
+/* Determine the vectors of a range that lead from a square to a square on the
+ * board
+ * @param sq square on the board
+ * @param kbeg start of range of vector indices
+ * @param kend end of range of vector indices; kend-kbeg<vec_set_word_bits
+ * @return bit k-kbeg is set iff sq+vec[k] is on the board
+ */
+vec_set_word_type vec_on_board_in_range(square sq,
+                                        vec_index_type kbeg,
+                                        vec_index_type kend);
 
 #endif
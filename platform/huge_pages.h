@@ -0,0 +1,24 @@
+#if !defined(PLATFORM_HUGE_PAGES_H)
+#define PLATFORM_HUGE_PAGES_H
+
+#include <stddef.h>
+
+/* Allocation of big chunks of memory that are accessed randomly (e.g. the
+ * arena of the hash table). Where the platform supports it, the memory is
+ * backed by huge pages, which reduces the number of TLB misses.
+ * Implemented separately for each platform.
+ */
+
+/* Allocate memory, backed by huge pages if possible
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory; 0 if allocation failed
+ */
+void *platform_allocate_huge_pages(size_t size);
+
+/* Free memory allocated with platform_allocate_huge_pages()
+ * @param memory address of the memory
+ * @param size number of bytes passed to platform_allocate_huge_pages()
+ */
+void platform_free_huge_pages(void *memory, size_t size);
+
+#endif
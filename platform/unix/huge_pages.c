@@ -0,0 +1,63 @@
+/* anonymous memory mappings aren't part of POSIX */
+#define _DEFAULT_SOURCE
+
+#include "platform/huge_pages.h"
+
+#include <sys/mman.h>
+
+/* transparent huge pages are 2MB on the usual Linux platforms */
+static size_t const huge_page_size = 2*1024*1024;
+
+static size_t round_to_huge_pages(size_t size)
+{
+  return (size+huge_page_size-1) & ~(huge_page_size-1);
+}
+
+/* Allocate memory, backed by huge pages if possible
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory; 0 if allocation failed
+ */
+void *platform_allocate_huge_pages(size_t size)
+{
+#if defined(MAP_ANONYMOUS)
+  int const flags = MAP_PRIVATE|MAP_ANONYMOUS;
+#else
+  int const flags = MAP_PRIVATE|MAP_ANON;
+#endif
+  size_t const rounded_size = round_to_huge_pages(size);
+
+  /* map an extra huge page so that we can start at a huge page boundary */
+  size_t const mapped_size = rounded_size+huge_page_size;
+  char * const mapped = mmap(0,mapped_size,PROT_READ|PROT_WRITE,flags,-1,0);
+
+  if (mapped==MAP_FAILED)
+    return 0;
+  else
+  {
+    char * const result = (char *)round_to_huge_pages((size_t)mapped);
+    size_t const head = (size_t)(result-mapped);
+    size_t const tail = mapped_size-head-rounded_size;
+
+    if (head>0)
+      munmap(mapped,head);
+    if (tail>0)
+      munmap(result+rounded_size,tail);
+
+#if defined(MADV_HUGEPAGE)
+    /* only a hint; the kernel may not support it or have it disabled */
+    madvise(result,rounded_size,MADV_HUGEPAGE);
+#endif
+
+    return result;
+  }
+}
+
+/* Free memory allocated with platform_allocate_huge_pages()
+ * @param memory address of the memory
+ * @param size number of bytes passed to platform_allocate_huge_pages()
+ */
+void platform_free_huge_pages(void *memory, size_t size)
+{
+  if (memory!=0)
+    munmap(memory,round_to_huge_pages(size));
+}
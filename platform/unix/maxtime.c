@@ -26,6 +26,14 @@ static void ReportSignalAndBailOut(int sig)
 }
 
 /* specific signal handlers: */
+static void TerminateSavingHashTable(int sig)
+{
+  hash_terminate(sig);
+  /* termination is deferred if the snapshot of the hash table is to be
+   * written */
+  signal(sig, &TerminateSavingHashTable);
+}
+
 #if defined(HASHRATE)
 static void sigUsr1Handler(int sig)
 {
@@ -38,6 +46,13 @@ static void sigUsr2Handler(int sig)
   DecHashRateLevel();
   signal(sig, &sigUsr2Handler);
 }
+#else
+static void sigUsr1Handler(int sig)
+{
+  /* writing isn't async-signal-safe */
+  hash_schedule_statistics_report();
+  signal(sig, &sigUsr1Handler);
+}
 #endif
 
 /* this initialisation is valid only for Unix.
@@ -156,9 +171,13 @@ void platform_init(void)
 #if defined(HASHRATE)
   signal(SIGUSR1, &sigUsr1Handler);
   signal(SIGUSR2, &sigUsr2Handler);
+#else
+  signal(SIGUSR1, &sigUsr1Handler);
 #endif /*HASHRATE*/
   signal(SIGALRM, &solvingTimeOver);
   signal(SIGHUP,  &ReDrawBoard);
+  signal(SIGINT,  &TerminateSavingHashTable);
+  signal(SIGTERM, &TerminateSavingHashTable);
 }
 
 boolean platform_set_maxtime_timer(maxtime_type seconds)
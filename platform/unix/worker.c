@@ -0,0 +1,123 @@
+/* anonymous memory mappings aren't part of POSIX */
+#define _DEFAULT_SOURCE
+
+#include "platform/worker.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* Determine whether worker processes are supported on this platform
+ * @return true iff worker processes are supported
+ */
+boolean platform_are_workers_supported(void)
+{
+  return true;
+}
+
+/* Allocate memory that will be shared with the worker processes started
+ * afterwards
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory; 0 if allocation failed
+ */
+void *platform_allocate_shared_memory(size_t size)
+{
+#if defined(MAP_ANONYMOUS)
+  int const flags = MAP_SHARED|MAP_ANONYMOUS;
+#else
+  int const flags = MAP_SHARED|MAP_ANON;
+#endif
+  void * const result = mmap(0,size,PROT_READ|PROT_WRITE,flags,-1,0);
+  return result==MAP_FAILED ? 0 : result;
+}
+
+/* Free memory allocated with platform_allocate_shared_memory()
+ * @param memory address of the memory
+ * @param size number of bytes passed to platform_allocate_shared_memory()
+ */
+void platform_free_shared_memory(void *memory, size_t size)
+{
+  if (memory!=0)
+    munmap(memory,size);
+}
+
+/* Atomically increment a counter shared between processes
+ * @param counter address of the counter in shared memory
+ * @return value of the counter before the increment
+ */
+unsigned long platform_fetch_and_increment(unsigned long volatile *counter)
+{
+  return __sync_fetch_and_add(counter,1);
+}
+
+/* Start a worker process
+ * @param output file where the worker's regular output is to be written to
+ * @return worker_start_in_worker in the new worker process
+ *         worker_start_in_parent in the parent process
+ *         worker_start_failed if no worker process could be started
+ */
+worker_start_result_type platform_start_worker(FILE *output)
+{
+  pid_t pid;
+
+  /* make sure that buffered output isn't written by both processes */
+  fflush(0);
+
+  pid = fork();
+  if (pid==-1)
+    return worker_start_failed;
+  else if (pid==0)
+  {
+    dup2(fileno(output),STDOUT_FILENO);
+    return worker_start_in_worker;
+  }
+  else
+    return worker_start_in_parent;
+}
+
+/* Determine the current position in the output file of the worker process
+ * invoking this function
+ * @return position (number of bytes written so far)
+ */
+unsigned long platform_get_worker_output_position(void)
+{
+  fflush(stdout);
+  return (unsigned long)lseek(STDOUT_FILENO,0,SEEK_CUR);
+}
+
+/* Terminate the worker process invoking this function
+ */
+void platform_end_worker(void)
+{
+  fflush(stdout);
+  /* don't run any exit handlers or flush any other streams (e.g. the input
+   * file) - they belong to our parent process */
+  _exit(0);
+}
+
+/* Wait until all the worker processes started by the invoking process have
+ * terminated
+ * @return true iff all workers have terminated regularly
+ */
+boolean platform_wait_for_workers(void)
+{
+  boolean result = true;
+
+  while (true)
+  {
+    int status;
+    pid_t const pid = wait(&status);
+    if (pid==-1)
+    {
+      if (errno!=EINTR)
+        break;
+    }
+    else if (!WIFEXITED(status) || WEXITSTATUS(status)!=0)
+      result = false;
+  }
+
+  return result;
+}
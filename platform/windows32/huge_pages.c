@@ -0,0 +1,25 @@
+#include "platform/huge_pages.h"
+
+#include <stdlib.h>
+
+/* Large pages require a user privilege on Windows that we can't count on;
+ * use regular memory.
+ */
+
+/* Allocate memory, backed by huge pages if possible
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory; 0 if allocation failed
+ */
+void *platform_allocate_huge_pages(size_t size)
+{
+  return malloc(size);
+}
+
+/* Free memory allocated with platform_allocate_huge_pages()
+ * @param memory address of the memory
+ * @param size number of bytes passed to platform_allocate_huge_pages()
+ */
+void platform_free_huge_pages(void *memory, size_t size)
+{
+  free(memory);
+}
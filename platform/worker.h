@@ -0,0 +1,71 @@
+#if !defined(PLATFORM_WORKER_H)
+#define PLATFORM_WORKER_H
+
+#include "utilities/boolean.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+/* Functions for running parts of the solving in worker processes.
+ * Each worker process starts with a copy of the state of its parent process.
+ * Workers and parent communicate through shared memory allocated before the
+ * workers are started; the regular output of a worker is written to a file
+ * of its own.
+ */
+
+typedef enum
+{
+  worker_start_failed,
+  worker_start_in_parent,
+  worker_start_in_worker
+} worker_start_result_type;
+
+/* Determine whether worker processes are supported on this platform
+ * @return true iff worker processes are supported
+ */
+boolean platform_are_workers_supported(void);
+
+/* Allocate memory that will be shared with the worker processes started
+ * afterwards
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory; 0 if allocation failed
+ */
+void *platform_allocate_shared_memory(size_t size);
+
+/* Free memory allocated with platform_allocate_shared_memory()
+ * @param memory address of the memory
+ * @param size number of bytes passed to platform_allocate_shared_memory()
+ */
+void platform_free_shared_memory(void *memory, size_t size);
+
+/* Atomically increment a counter shared between processes
+ * @param counter address of the counter in shared memory
+ * @return value of the counter before the increment
+ */
+unsigned long platform_fetch_and_increment(unsigned long volatile *counter);
+
+/* Start a worker process
+ * @param output file where the worker's regular output is to be written to
+ * @return worker_start_in_worker in the new worker process
+ *         worker_start_in_parent in the parent process
+ *         worker_start_failed if no worker process could be started
+ */
+worker_start_result_type platform_start_worker(FILE *output);
+
+/* Determine the current position in the output file of the worker process
+ * invoking this function
+ * @return position (number of bytes written so far)
+ */
+unsigned long platform_get_worker_output_position(void);
+
+/* Terminate the worker process invoking this function
+ */
+void platform_end_worker(void);
+
+/* Wait until all the worker processes started by the invoking process have
+ * terminated
+ * @return true iff all workers have terminated regularly
+ */
+boolean platform_wait_for_workers(void);
+
+#endif
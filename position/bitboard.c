@@ -0,0 +1,339 @@
+#include "position/bitboard.h"
+#include "pieces/walks/vectors.h"
+#include "debugging/trace.h"
+#include "debugging/assert.h"
+
+bitboard_type bitboard_king_attacks[nr_squares_on_board];
+bitboard_type bitboard_knight_attacks[nr_squares_on_board];
+bitboard_type bitboard_pawn_attackers[nr_sides][nr_squares_on_board];
+bitboard_type bitboard_rays[nr_bitboard_dirs][nr_squares_on_board];
+bitboard_type bitboard_rook_neighbours[nr_squares_on_board];
+bitboard_type bitboard_bishop_neighbours[nr_squares_on_board];
+bitboard_dir_type bitboard_dir_of_vec[vec_queen_end+1];
+
+bitboard_magic_type bitboard_rook_magics[nr_squares_on_board];
+bitboard_magic_type bitboard_bishop_magics[nr_squares_on_board];
+
+enum
+{
+  /* sums of 1<<(number of bits in the masks) over the squares */
+  rook_attacks_table_size = 102400,
+  bishop_attacks_table_size = 5248,
+
+  max_nr_relevant_occupations = 1<<12
+};
+
+static bitboard_type rook_attacks_table[rook_attacks_table_size];
+static bitboard_type bishop_attacks_table[bishop_attacks_table_size];
+
+static bitboard_dir_type const rook_dirs[] =
+{
+  bitboard_dir_up, bitboard_dir_right, bitboard_dir_down, bitboard_dir_left
+};
+
+static bitboard_dir_type const bishop_dirs[] =
+{
+  bitboard_dir_up_left, bitboard_dir_up_right,
+  bitboard_dir_down_right, bitboard_dir_down_left
+};
+
+enum
+{
+  nr_slider_dirs = sizeof rook_dirs / sizeof rook_dirs[0]
+};
+
+static numvec const ray_vectors[nr_bitboard_dirs] =
+{
+  dir_up,
+  dir_right,
+  dir_up+dir_left,
+  dir_up+dir_right,
+  dir_down,
+  dir_left,
+  dir_down+dir_right,
+  dir_down+dir_left
+};
+
+#if !defined(__GNUC__)
+/* Determine the index of the lowest bit set in a bitboard
+ * @param b bitboard; !=0
+ */
+unsigned int bitboard_lowest_index(bitboard_type b)
+{
+  unsigned int result = 0;
+
+  assert(b!=0);
+
+  while ((b&1)==0)
+  {
+    b >>= 1;
+    ++result;
+  }
+
+  return result;
+}
+
+/* Determine the index of the highest bit set in a bitboard
+ * @param b bitboard; !=0
+ */
+unsigned int bitboard_highest_index(bitboard_type b)
+{
+  unsigned int result = 0;
+
+  assert(b!=0);
+
+  while (b>>=1)
+    ++result;
+
+  return result;
+}
+#endif
+
+static bitboard_type leaper_attacks(square from,
+                                    vec_index_type kbeg, vec_index_type kend)
+{
+  bitboard_type result = 0;
+  vec_index_type k;
+
+  for (k = kbeg; k<=kend; ++k)
+  {
+    square const to = from+vec[k];
+    if (is_on_board(to))
+      result |= bitboard_of_square(to);
+  }
+
+  return result;
+}
+
+static bitboard_type ray(square from, numvec dir)
+{
+  bitboard_type result = 0;
+  square to;
+
+  for (to = from+dir; is_on_board(to); to += dir)
+    result |= bitboard_of_square(to);
+
+  return result;
+}
+
+static unsigned int count_bits(bitboard_type b)
+{
+  unsigned int result = 0;
+
+  for (; b!=0; b &= b-1)
+    ++result;
+
+  return result;
+}
+
+/* index of the nearest resp. farthest square of a (non-empty) set of
+ * squares on a ray */
+#define nearest_on_ray(dir,b) \
+  ((dir)<nr_bitboard_dirs_increasing ? bitboard_lowest_index(b) : bitboard_highest_index(b))
+#define farthest_on_ray(dir,b) \
+  ((dir)<nr_bitboard_dirs_increasing ? bitboard_highest_index(b) : bitboard_lowest_index(b))
+
+/* the squares of the rays whose occupation determines the squares attacked,
+ * i.e. without the last square of each ray */
+static bitboard_type relevant_mask(unsigned int idx,
+                                   bitboard_dir_type const dirs[nr_slider_dirs])
+{
+  bitboard_type result = 0;
+  unsigned int i;
+
+  for (i = 0; i!=nr_slider_dirs; ++i)
+  {
+    bitboard_type const ray = bitboard_rays[dirs[i]][idx];
+    if (ray!=0)
+      result |= ray & ~(((bitboard_type)1)<<farthest_on_ray(dirs[i],ray));
+  }
+
+  return result;
+}
+
+static bitboard_type slider_attacks(unsigned int idx,
+                                    bitboard_dir_type const dirs[nr_slider_dirs],
+                                    bitboard_type occupied)
+{
+  bitboard_type result = 0;
+  unsigned int i;
+
+  for (i = 0; i!=nr_slider_dirs; ++i)
+  {
+    bitboard_type const ray = bitboard_rays[dirs[i]][idx];
+    bitboard_type const blockers = ray&occupied;
+    if (blockers==0)
+      result |= ray;
+    else
+      result |= ray ^ bitboard_rays[dirs[i]][nearest_on_ray(dirs[i],blockers)];
+  }
+
+  return result;
+}
+
+/* magic factors mapping the relevant occupations of each square to indices
+ * in the attacks table without destructive collisions; found by trial and
+ * error */
+static bitboard_type const rook_magic_factors[nr_squares_on_board] =
+{
+  0x008000908064c000ULL, 0x0040200040001000ULL, 0x0180100080a0010aULL,
+  0x8880041000800800ULL, 0x1200100201200804ULL, 0x0200020004011008ULL,
+  0x2180010000800600ULL, 0x0200005088210204ULL, 0x0400800040008021ULL,
+  0x0400400020005000ULL, 0x8240801000200080ULL, 0x8611001004200900ULL,
+  0x008180800c001800ULL, 0x0100800200800400ULL, 0x0a02000102000408ULL,
+  0x8020802300104280ULL, 0x0080004000402000ULL, 0xe010104000402000ULL,
+  0x0800808010002000ULL, 0xa280210008100100ULL, 0x0001818014000800ULL,
+  0xa002010100080400ULL, 0x0080240001020870ULL, 0x0001020004048845ULL,
+  0x0081826280004004ULL, 0x2020810900284000ULL, 0x0200100080802000ULL,
+  0x0200080080100080ULL, 0x8083080100100500ULL, 0x4406000901000400ULL,
+  0x0005020080800100ULL, 0x0090204200008114ULL, 0x0010400094800420ULL,
+  0x0900804000802002ULL, 0x0201001841002000ULL, 0x4100080080801000ULL,
+  0x4540040080800800ULL, 0x0002001004040020ULL, 0x0281195814001002ULL,
+  0x1240800040800100ULL, 0x0880042000524004ULL, 0x02c080410206002cULL,
+  0x0801200241050010ULL, 0x8400080010008080ULL, 0x0008000500090010ULL,
+  0x0082009084020008ULL, 0x4012000108020004ULL, 0x9000104d08860004ULL,
+  0x2004204114800100ULL, 0x0148802112400300ULL, 0x0202842000100880ULL,
+  0x001b080080900080ULL, 0x001a002008100600ULL, 0x0004008004020080ULL,
+  0x5181000600040300ULL, 0x0000044401128a00ULL, 0x8044110480002441ULL,
+  0x2008110084402202ULL, 0x90806005090010c1ULL, 0x000420310a004a42ULL,
+  0x0023001004020801ULL, 0x0882001008040102ULL, 0x000230088118020cULL,
+  0x0000019025040042ULL
+};
+
+static bitboard_type const bishop_magic_factors[nr_squares_on_board] =
+{
+  0x0045010808008680ULL, 0x2002080204004898ULL, 0x0210009a10400006ULL,
+  0x0824050200810200ULL, 0x0006061105004090ULL, 0x00010108c0000000ULL,
+  0x0814040282104004ULL, 0x0012012201106800ULL, 0x10823014100c1040ULL,
+  0x0080c2088802808cULL, 0x0281108410404000ULL, 0x0101212041826200ULL,
+  0x0020141028221058ULL, 0x2201020202200202ULL, 0x000082a801482000ULL,
+  0x0000008401411044ULL, 0x0007103014300404ULL, 0x0002091110010100ULL,
+  0x42140012040c0808ULL, 0x0800808802004020ULL, 0x90c4004210140000ULL,
+  0x0800200900a01000ULL, 0x00d0400201108810ULL, 0x80820183814412a0ULL,
+  0x00a01008202202b4ULL, 0x01c2021a09500402ULL, 0x0084440208042400ULL,
+  0x800400400c090100ULL, 0xba10040010802100ULL, 0xd182009006005000ULL,
+  0x5011021001009004ULL, 0x0020420200510400ULL, 0x0292104000468800ULL,
+  0x00043009091c0500ULL, 0x0280441000020025ULL, 0x0042820080080080ULL,
+  0x0440101010010040ULL, 0x1000900100808080ULL, 0x0108108120089800ULL,
+  0x0044010200012682ULL, 0xc002500420900400ULL, 0x0040482210710800ULL,
+  0x0002060024000200ULL, 0x0281020a44000800ULL, 0xa0021200a4000200ULL,
+  0x0001301000840840ULL, 0x2868500108444220ULL, 0x0004111041000200ULL,
+  0x8044020842080200ULL, 0x0000220104210200ULL, 0x0000021201044000ULL,
+  0x0000280884040028ULL, 0x4012114010858003ULL, 0x0000081004082b88ULL,
+  0x3892700508208002ULL, 0x00220a041b060400ULL, 0x0812020284014881ULL,
+  0x010434a282103100ULL, 0x0490400824020800ULL, 0x4a20002c00208800ULL,
+  0x000000a011020200ULL, 0x4002940a02482202ULL, 0x5100100202140406ULL,
+  0x02102000840540c1ULL
+};
+
+static void init_magics(bitboard_magic_type magics[nr_squares_on_board],
+                        bitboard_dir_type const dirs[nr_slider_dirs],
+                        bitboard_type const magic_factors[nr_squares_on_board],
+                        bitboard_type table[], unsigned int table_size)
+{
+  static bitboard_type occupations[max_nr_relevant_occupations];
+  static bitboard_type attacks[max_nr_relevant_occupations];
+  unsigned int idx;
+  unsigned int table_used = 0;
+
+  for (idx = 0; idx!=nr_squares_on_board; ++idx)
+  {
+    bitboard_magic_type * const m = magics+idx;
+    unsigned int nr_occupations = 0;
+    bitboard_type occupied = 0;
+
+    m->mask = relevant_mask(idx,dirs);
+    m->shift = 64-count_bits(m->mask);
+    m->attacks = table+table_used;
+
+    /* enumerate the subsets of the mask */
+    do
+    {
+      assert(nr_occupations<max_nr_relevant_occupations);
+      occupations[nr_occupations] = occupied;
+      attacks[nr_occupations] = slider_attacks(idx,dirs,occupied);
+      ++nr_occupations;
+      occupied = (occupied-m->mask)&m->mask;
+    } while (occupied!=0);
+
+#if defined(__BMI2__)
+    m->magic = 0;
+#else
+    m->magic = magic_factors[idx];
+#endif
+
+    {
+      unsigned int i;
+      for (i = 0; i!=nr_occupations; ++i)
+      {
+        unsigned int const index = bitboard_magic_index(m,occupations[i]);
+        assert(index<nr_occupations);
+        assert(m->attacks[index]==0 || m->attacks[index]==attacks[i]);
+        m->attacks[index] = attacks[i];
+      }
+    }
+
+    table_used += nr_occupations;
+  }
+
+  assert(table_used==table_size);
+}
+
+/* Initialise the attack tables
+ */
+void bitboard_init_attack_tables(void)
+{
+  unsigned int i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  for (i = 0; i!=nr_squares_on_board; ++i)
+  {
+    square const s = bitboard_square(i);
+    bitboard_dir_type dir;
+
+    assert(bitboard_index(s)==i);
+
+    bitboard_king_attacks[i] = leaper_attacks(s,vec_queen_start,vec_queen_end);
+    bitboard_knight_attacks[i] = leaper_attacks(s,vec_knight_start,vec_knight_end);
+
+    bitboard_pawn_attackers[White][i] = 0;
+    if (is_on_board(s-dir_up-dir_left))
+      bitboard_pawn_attackers[White][i] |= bitboard_of_square(s-dir_up-dir_left);
+    if (is_on_board(s-dir_up-dir_right))
+      bitboard_pawn_attackers[White][i] |= bitboard_of_square(s-dir_up-dir_right);
+
+    bitboard_pawn_attackers[Black][i] = 0;
+    if (is_on_board(s-dir_down-dir_left))
+      bitboard_pawn_attackers[Black][i] |= bitboard_of_square(s-dir_down-dir_left);
+    if (is_on_board(s-dir_down-dir_right))
+      bitboard_pawn_attackers[Black][i] |= bitboard_of_square(s-dir_down-dir_right);
+
+    for (dir = 0; dir!=nr_bitboard_dirs; ++dir)
+      bitboard_rays[dir][i] = ray(s,ray_vectors[dir]);
+
+    bitboard_rook_neighbours[i] = leaper_attacks(s,vec_rook_start,vec_rook_end);
+    bitboard_bishop_neighbours[i] = leaper_attacks(s,vec_bishop_start,vec_bishop_end);
+  }
+
+  {
+    vec_index_type k;
+    for (k = vec_queen_start; k<=vec_queen_end; ++k)
+    {
+      bitboard_dir_type dir = 0;
+      while (ray_vectors[dir]!=vec[k])
+        ++dir;
+      assert(dir<nr_bitboard_dirs);
+      bitboard_dir_of_vec[k] = dir;
+    }
+  }
+
+  init_magics(bitboard_rook_magics,rook_dirs,rook_magic_factors,
+              rook_attacks_table,rook_attacks_table_size);
+  init_magics(bitboard_bishop_magics,bishop_dirs,bishop_magic_factors,
+              bishop_attacks_table,bishop_attacks_table_size);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,140 @@
+#if !defined(POSITION_BITBOARD_H)
+#define POSITION_BITBOARD_H
+
+#include "position/board.h"
+#include "position/side.h"
+#include "pieces/pieces.h"
+#include "pieces/walks/vectors.h"
+
+/* This module provides a bitboard representation of the placement of the
+ * pieces, which is maintained in parallel to the board (cf. position.h), and
+ * tables of the squares attacked by the orthodox pieces.
+ * Bit i of a bitboard represents boardnum[i], i.e. bit 0 represents a1, bit 7
+ * h1, bit 8 a2 ... and bit 63 h8.
+ */
+
+typedef unsigned long long bitboard_type;
+
+/* the orthodox walks have their own bitboards */
+#define bitboard_first_walk King
+#define bitboard_last_walk Bishop
+
+enum
+{
+  nr_bitboard_walks = Bishop-King+1
+};
+
+typedef struct
+{
+    bitboard_type occupied;                         /* pieces and holes */
+    bitboard_type side[nr_sides];                   /* neutral pieces belong to both sides */
+    bitboard_type walk[nr_sides][nr_bitboard_walks];
+
+    /* squares whose contents have been modified since the king square attack
+     * cache last collected them */
+    bitboard_type modified;
+} bitboards_type;
+
+/* index of the bit representing an (on-board!) square */
+#define bitboard_index(s) \
+  ((unsigned int)(((s)-square_a1)/onerow*nr_files_on_board \
+                  + ((s)-square_a1)%onerow))
+#define bitboard_of_square(s) (((bitboard_type)1)<<bitboard_index(s))
+
+/* the square represented by bit i */
+#define bitboard_square(i) (boardnum[(i)])
+
+#define is_bitboard_walk(walk) \
+  (bitboard_first_walk<=(walk) && (walk)<=bitboard_last_walk)
+
+/* bitboard of the pieces of a side having an orthodox walk */
+#define bitboard_of_walk(bitboards,side,w) \
+  ((bitboards)->walk[(side)][(w)-bitboard_first_walk])
+
+/* Determine the index of the lowest resp. highest bit set in a bitboard
+ * @param b bitboard; !=0
+ */
+#if defined(__GNUC__)
+#define bitboard_lowest_index(b) ((unsigned int)__builtin_ctzll(b))
+#define bitboard_highest_index(b) ((unsigned int)(63-__builtin_clzll(b)))
+#else
+unsigned int bitboard_lowest_index(bitboard_type b);
+unsigned int bitboard_highest_index(bitboard_type b);
+#endif
+
+/* the directions of the orthodox riders in the order of increasing resp.
+ * decreasing bit indices
+ */
+typedef enum
+{
+  bitboard_dir_up,
+  bitboard_dir_right,
+  bitboard_dir_up_left,
+  bitboard_dir_up_right,
+
+  bitboard_dir_down,
+  bitboard_dir_left,
+  bitboard_dir_down_right,
+  bitboard_dir_down_left,
+
+  nr_bitboard_dirs,
+  nr_bitboard_dirs_increasing = bitboard_dir_down
+} bitboard_dir_type;
+
+/* squares attacked by a king resp. a knight standing on the indexed square */
+extern bitboard_type bitboard_king_attacks[nr_squares_on_board];
+extern bitboard_type bitboard_knight_attacks[nr_squares_on_board];
+
+/* squares from where a pawn of a side attacks the indexed square */
+extern bitboard_type bitboard_pawn_attackers[nr_sides][nr_squares_on_board];
+
+/* squares reached by a rider from the indexed square in a direction, not
+ * including the indexed square */
+extern bitboard_type bitboard_rays[nr_bitboard_dirs][nr_squares_on_board];
+
+/* squares adjacent to the indexed square orthogonally resp. diagonally */
+extern bitboard_type bitboard_rook_neighbours[nr_squares_on_board];
+extern bitboard_type bitboard_bishop_neighbours[nr_squares_on_board];
+
+/* direction of the vector vec[k] for vec_queen_start<=k<=vec_queen_end */
+extern bitboard_dir_type bitboard_dir_of_vec[vec_queen_end+1];
+
+/* The squares attacked by a rook or bishop are looked up in tables indexed by
+ * the pieces on the lines through its square ("magic bitboards").
+ * If the BMI2 instruction set is available, the index is extracted using PEXT;
+ * otherwise it is computed by multiplying with a "magic" factor.
+ */
+typedef struct
+{
+    bitboard_type mask;      /* the squares whose occupation matters */
+    bitboard_type magic;
+    unsigned int shift;
+    bitboard_type *attacks;
+} bitboard_magic_type;
+
+extern bitboard_magic_type bitboard_rook_magics[nr_squares_on_board];
+extern bitboard_magic_type bitboard_bishop_magics[nr_squares_on_board];
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#define bitboard_magic_index(m,occupied) \
+  ((unsigned int)_pext_u64((occupied),(m)->mask))
+#else
+#define bitboard_magic_index(m,occupied) \
+  ((unsigned int)((((occupied)&(m)->mask)*(m)->magic)>>(m)->shift))
+#endif
+
+#define bitboard_slider_attacks(magics,idx,occupied) \
+  ((magics)[(idx)].attacks[bitboard_magic_index((magics)+(idx),(occupied))])
+
+/* squares attacked by a rook resp. bishop on the square with bit index idx */
+#define bitboard_rook_attacks(idx,occupied) \
+  bitboard_slider_attacks(bitboard_rook_magics,(idx),(occupied))
+#define bitboard_bishop_attacks(idx,occupied) \
+  bitboard_slider_attacks(bitboard_bishop_magics,(idx),(occupied))
+
+/* Initialise the attack tables
+ */
+void bitboard_init_attack_tables(void);
+
+#endif
@@ -3,10 +3,11 @@
 #include "debugging/trace.h"
 #include "debugging/assert.h"
 
-boolean areColorsSwapped;
-boolean isBoardReflected;
-
-position being_solved;
+#if defined(AUXILIARY)
+/* the host program generating the game array isn't linked with
+ * solving/context.c */
+SOLVING_CONTEXT_STORAGE solving_context_type solving_context;
+#endif
 
 /* This is the InitialGameArray */
 piece_walk_type const PAS[nr_squares_on_board] = {
@@ -90,6 +91,9 @@ void initialise_game_array(position *pos)
     pos->isquare[i] = initsquare;
 
   pos->castling_rights = wh_castlings|bl_castlings;
+
+  pos->hash_key = calculate_hash_key(pos);
+  calculate_bitboards(pos,&pos->bitboards);
 }
 
 /* Swap the sides of all the pieces */
@@ -107,6 +111,9 @@ void swap_sides(void)
         && !is_square_blocked(*bnp))
       piece_change_side(&being_solved.spec[*bnp]);
 
+  recompute_hash_key();
+  recompute_bitboards();
+
   areColorsSwapped = !areColorsSwapped;
 }
 
@@ -140,6 +147,8 @@ void reflect_position(void)
   }
 
   swap_castling_rights();
+  recompute_hash_key();
+  recompute_bitboards();
 
   isBoardReflected = !isBoardReflected;
 }
@@ -152,8 +161,95 @@ void piece_change_side(Flags *spec)
   *spec ^= BIT(Black)|BIT(White);
 }
 
+/* flags of the pieces represented in the hash key */
+static Flags hash_key_flags_mask = ~(Flags)0;
+
+/* Determine the contribution of a piece to the hash key of a position.
+ * Rather than looking up a table of random numbers indexed by square, walk and
+ * flags, we scramble these three values; the result has the same properties,
+ * but we don't have to keep a table of nr_piece_walks*maxsquare*nr_flag_sets
+ * numbers.
+ * @param s where the piece stands
+ * @param walk the piece's walk
+ * @param flags the piece's flags
+ * @return contribution of the piece to the first word of the hash key
+ */
+static hash_key_type piece_hash_key(square s, piece_walk_type walk, Flags flags)
+{
+  /* splitmix64 finaliser */
+  hash_key_type result = (((hash_key_type)s<<40)
+                          ^ ((hash_key_type)walk<<32)
+                          ^ (hash_key_type)(flags&hash_key_flags_mask));
+  result += 0x9E3779B97F4A7C15ULL;
+  result = (result ^ (result>>30)) * 0xBF58476D1CE4E5B9ULL;
+  result = (result ^ (result>>27)) * 0x94D049BB133111EBULL;
+  return result ^ (result>>31);
+}
+
+/* Add or remove the contribution of a piece to or from a hash key
+ * @param key address of the hash key
+ * @param s where the piece stands
+ * @param walk the piece's walk
+ * @param flags the piece's flags
+ */
+static void toggle_piece_hash_key(position_key_type *key,
+                                  square s,
+                                  piece_walk_type walk, Flags flags)
+{
+  if (walk!=Empty)
+  {
+    hash_key_type const contribution = piece_hash_key(s,walk,flags);
+    key->word[0] ^= contribution;
+    /* scrambling the contribution once more is considerably cheaper than
+     * scrambling square, walk and flags with a second increment */
+    key->word[1] ^= (contribution ^ (contribution>>29)) * 0xD1B54A32D192ED03ULL;
+  }
+}
+
+#define toggle_square_hash_key(s) \
+  toggle_piece_hash_key(&being_solved.hash_key,(s),being_solved.board[(s)],being_solved.spec[(s)])
+
+/* Add or remove the piece on a square to or from a set of bitboards
+ * @param bitboards address of the bitboards
+ * @param s square; may be off the board
+ * @param walk walk of the piece
+ * @param flags flags of the piece
+ */
+static void toggle_piece_bitboards(bitboards_type *bitboards,
+                                   square s,
+                                   piece_walk_type walk, Flags flags)
+{
+  unsigned int const row = (unsigned int)s/onerow;
+  unsigned int const file = (unsigned int)s%onerow;
+
+  if (walk!=Empty
+      && bottom_row<=row && row<=top_row
+      && left_file<=file && file<=right_file)
+  {
+    bitboard_type const bit = ((bitboard_type)1)<<((row-bottom_row)*nr_files_on_board
+                                                   +file-left_file);
+    Side side;
+
+    bitboards->occupied ^= bit;
+    bitboards->modified |= bit;
+
+    for (side = White; side!=nr_sides; ++side)
+      if (TSTFLAG(flags,side))
+      {
+        bitboards->side[side] ^= bit;
+        if (is_bitboard_walk(walk))
+          bitboard_of_walk(bitboards,side,walk) ^= bit;
+      }
+  }
+}
+
+#define toggle_square_bitboards(s) \
+  toggle_piece_bitboards(&being_solved.bitboards,(s),being_solved.board[(s)],being_solved.spec[(s)])
+
 void empty_square(square s)
 {
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
   being_solved.board[s] = Empty;
   being_solved.spec[s] = EmptySpec;
 }
@@ -162,22 +258,111 @@ void occupy_square(square s, piece_walk_type walk, Flags flags)
 {
   assert(walk!=Empty);
   assert(walk!=Invalid);
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
   being_solved.board[s] = walk;
   being_solved.spec[s] = flags;
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
 }
 
 void replace_walk(square s, piece_walk_type walk)
 {
   assert(walk!=Empty);
   assert(walk!=Invalid);
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
   being_solved.board[s] = walk;
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
+}
+
+void replace_flags(square s, Flags flags)
+{
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
+  being_solved.spec[s] = flags;
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
 }
 
 void block_square(square s)
 {
   assert(is_square_empty(s) || is_square_blocked(s));
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
   being_solved.board[s] = Invalid;
   being_solved.spec[s] = BorderSpec;
+  toggle_square_hash_key(s);
+  toggle_square_bitboards(s);
+}
+
+/* Compute a position's hash key from scratch
+ * @param pos address of position
+ * @return the hash key
+ */
+position_key_type calculate_hash_key(position const *pos)
+{
+  position_key_type result = { { 0 } };
+  square s;
+
+  /* include the border squares, which are modified using the same functions */
+  for (s = 0; s!=maxsquare; ++s)
+    toggle_piece_hash_key(&result,s,pos->board[s],pos->spec[s]);
+
+  return result;
+}
+
+/* Recompute being_solved.hash_key from scratch
+ * @note only necessary after the board has been modified without using the
+ *       functions above (e.g. while reading or twinning a problem)
+ */
+void recompute_hash_key(void)
+{
+  being_solved.hash_key = calculate_hash_key(&being_solved);
+}
+
+/* Determine which flags of the pieces are represented in the hash key; by
+ * default, all are
+ * @param mask mask of the flags to be represented
+ * @note recomputes being_solved.hash_key
+ */
+void set_hash_key_flags_mask(Flags mask)
+{
+  hash_key_flags_mask = mask;
+  recompute_hash_key();
+}
+
+/* Compute a position's bitboards from scratch
+ * @param pos address of position
+ * @param bitboards where to write the bitboards
+ */
+void calculate_bitboards(position const *pos, bitboards_type *bitboards)
+{
+  square const *bnp;
+  piece_walk_type walk;
+
+  bitboards->occupied = 0;
+  bitboards->modified = ~(bitboard_type)0;
+  bitboards->side[White] = 0;
+  bitboards->side[Black] = 0;
+  for (walk = bitboard_first_walk; walk<=bitboard_last_walk; ++walk)
+  {
+    bitboard_of_walk(bitboards,White,walk) = 0;
+    bitboard_of_walk(bitboards,Black,walk) = 0;
+  }
+
+  for (bnp = boardnum; *bnp; ++bnp)
+    toggle_piece_bitboards(bitboards,*bnp,pos->board[*bnp],pos->spec[*bnp]);
+}
+
+/* Recompute being_solved.bitboards from scratch
+ * @note only necessary after the board has been modified without using the
+ *       functions above (e.g. while reading or twinning a problem)
+ */
+void recompute_bitboards(void)
+{
+  calculate_bitboards(&being_solved,&being_solved.bitboards);
 }
 
 square find_end_of_line(square from, numvec dir)
@@ -8,6 +8,7 @@
 #include "pieces/pieces.h"
 #include "pieces/walks/vectors.h"
 #include "position/castling_rights.h"
+#include "position/bitboard.h"
 #include "utilities/boolean.h"
 
 /* Declarations of types and functions related to chess positions
@@ -21,9 +22,6 @@ typedef piece_walk_type echiquier[maxsquare+5];
 /* Some useful symbols for dealing with these flags
  */
 
-extern boolean areColorsSwapped;
-extern boolean isBoardReflected;
-
 enum
 {
   BorderSpec = 0,
@@ -37,6 +35,23 @@ enum
 
 typedef square imarr[maxinum]; /* squares currently occupied by imitators */
 
+typedef unsigned long long hash_key_type;
+
+/* Zobrist style key of the placement of the pieces on the board.
+ * The hash table stores the key instead of the placement, so the key is two
+ * words wide to make it practically impossible that different placements
+ * share a key.
+ */
+enum
+{
+  nr_position_key_words = 2
+};
+
+typedef struct
+{
+    hash_key_type word[nr_position_key_words];
+} position_key_type;
+
 /* Structure containing the pieces of data that together represent a
  * position.
  */
@@ -50,9 +65,11 @@ typedef struct position
     unsigned number_of_pieces[nr_sides][nr_piece_walks]; /* number of piece kind */
     castling_rights_type castling_rights;
     PieceIdType currPieceId;
+    position_key_type hash_key;          /* updated by the functions below */
+    bitboards_type bitboards;            /* ditto */
 } position;
 
-extern position being_solved;
+/* being_solved is part of the solving context (cf. solving/context.h) */
 
 /* Sequence of pieces corresponding to the game array (a1..h1, a2..h2
  * ... a8..h8)
@@ -80,6 +97,38 @@ void empty_square(square s);
 void block_square(square s);
 void occupy_square(square s, piece_walk_type walk, Flags flags);
 void replace_walk(square s, piece_walk_type walk);
+void replace_flags(square s, Flags flags);
+
+/* Recompute being_solved.hash_key from scratch
+ * @note only necessary after the board has been modified without using the
+ *       functions above (e.g. while reading or twinning a problem)
+ */
+void recompute_hash_key(void);
+
+/* Compute a position's hash key from scratch
+ * @param pos address of position
+ * @return the hash key
+ */
+position_key_type calculate_hash_key(position const *pos);
+
+/* Determine which flags of the pieces are represented in the hash key; by
+ * default, all are
+ * @param mask mask of the flags to be represented
+ * @note recomputes being_solved.hash_key
+ */
+void set_hash_key_flags_mask(Flags mask);
+
+/* Recompute being_solved.bitboards from scratch
+ * @note only necessary after the board has been modified without using the
+ *       functions above (e.g. while reading or twinning a problem)
+ */
+void recompute_bitboards(void);
+
+/* Compute a position's bitboards from scratch
+ * @param pos address of position
+ * @param bitboards where to write the bitboards
+ */
+void calculate_bitboards(position const *pos, bitboards_type *bitboards);
 #define is_square_empty(s) (being_solved.board[(s)]==Empty)
 #define is_square_blocked(s) (being_solved.board[(s)]==Invalid)
 #define get_walk_of_piece_on_square(s) (being_solved.board[(s)])
@@ -91,4 +140,8 @@ square find_end_of_line(square from, numvec dir);
  */
 void piece_change_side(Flags *spec);
 
+/* the state of this module is part of the solving context */
+#define POSITION_POSITION_H_COMPLETE
+#include "solving/context.h"
+
 #endif
@@ -87,4 +87,14 @@ position const game_array =
   },
   0x77 /* castling_rights */
   , 0 /* currPieceId */
+  , { { 0xce9a532b06a955deULL, 0xefbc59fe3225f2faULL } } /* hash_key */
+  , { /* bitboards */
+      0xffff00000000ffffULL,
+      { 0xffffULL, 0xffff000000000000ULL },
+      {
+        { 0x10ULL, 0xff00ULL, 0x8ULL, 0x42ULL, 0x81ULL, 0x24ULL },
+        { 0x1000000000000000ULL, 0xff000000000000ULL, 0x800000000000000ULL, 0x4200000000000000ULL, 0x8100000000000000ULL, 0x2400000000000000ULL }
+      },
+      0xffffffffffffffffULL
+    }
 };
@@ -1,5 +1,6 @@
 #include "optimisations/hash.h"
 #include "solving/moves_traversal.h"
+#include "solving/context.h"
 #include "output/plaintext/language_dependant.h"
 #include "output/latex/latex.h"
 #include "platform/priority.h"
@@ -38,6 +39,8 @@ static void checkGlobalAssumptions(void)
 
 int main(int argc, char *argv[])
 {
+  solving_context_init();
+
   checkGlobalAssumptions();
 
   platform_set_nice_priority();
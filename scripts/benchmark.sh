@@ -0,0 +1,201 @@
+#! /bin/bash
+
+# Benchmark Popeye: repeatedly solve a set of input files and write the
+# processor time and the solving statistics (cf. command line option
+# -stats) of each problem to a CSV and a JSON file. If a baseline (the CSV
+# file written by an earlier benchmark) is indicated, compare the results
+# with it.
+#
+# Usage: benchmark.sh [-all] [-runs <n>] [-maxmem <memory>]
+#                     [-baseline <csvfile>] [-threshold <percent>]
+#                     [-out <stem>] [<inputfile> ...]
+#
+# -all        also solve the input files that take a loooooong time
+# -runs       number of times each input file is solved; defaults to 3
+# -maxmem     defaults to 1G
+# -baseline   CSV file written by an earlier benchmark
+# -threshold  minimal difference in percent for a problem to be reported
+#             as slower or faster than in the baseline; defaults to 10
+# -out        stem of the names of the files written (<stem>.csv and
+#             <stem>.json); defaults to benchmark
+#
+# If no input files are indicated, a set of input files from the
+# directories TESTS and EXAMPLES is solved.
+#
+# A problem is reported as slower (faster) than in the baseline if its
+# shortest time exceeds (falls below) the shortest time in the baseline by
+# more than the threshold and by more than the noise, i.e. the largest of
+# the differences between the longest and shortest time in both benchmarks
+# and of 10ms.
+# The exit status is 1 if a problem is slower than in the baseline.
+#
+# Uses: awk, mktemp
+
+SCRIPTDIR=$(dirname $0)
+POPEYEDIR=$(cd ${SCRIPTDIR}/.. && pwd)
+
+runs=3
+memory=1G
+baseline=
+threshold=10
+out=benchmark
+all=
+
+while [ $# -gt 0 ]
+do
+    case $1 in
+        -all) all=1; shift ;;
+        -runs) runs=$2; shift 2 ;;
+        -maxmem) memory=$2; shift 2 ;;
+        -baseline) baseline=$2; shift 2 ;;
+        -threshold) threshold=$2; shift 2 ;;
+        -out) out=$2; shift 2 ;;
+        *) break ;;
+    esac
+done
+
+if [ $# -gt 0 ]
+then
+    inputs="$@"
+else
+    inputs="TESTS/intell.inp TESTS/battle_play.inp TESTS/help_play.inp"
+    if [ -n "$all" ]
+    then
+        inputs="$inputs EXAMPLES/lengthy/helpdirectmate.inp EXAMPLES/lengthy/pseries.inp"
+    fi
+fi
+
+if [ -n "$baseline" -a ! -f "$baseline" ]
+then
+    echo "$0: baseline $baseline not found" >&2
+    exit 2
+fi
+
+# the input files write their protocols to the current directory
+workdir=$(mktemp -d)
+trap "rm -rf $workdir" EXIT
+
+# solve the input files; for each problem and run, write a line
+# <input>,<problem>,<time>,<played>,<generated>,<checks>,<probes>,<hits>,<tried>,<pruned>
+# to $workdir/runs
+for input in $inputs
+do
+    case $input in
+        /*) path=$input ;;
+        *) [ -f $input ] && path=$(pwd)/$input || path=$POPEYEDIR/$input ;;
+    esac
+
+    for ((i=1; $i<=$runs; i=$((i+1))))
+    do
+        echo "$input run $i" >&2
+        (cd $workdir && ${POPEYEDIR}/py -maxmem $memory -maxtrace 0 -stats $path) \
+        | awk -v input=$input '
+            function value(key) {
+              match($0,"\"" key "\":[0-9]+")
+              return substr($0,RSTART+length(key)+3,RLENGTH-length(key)-3)
+            }
+            /\{"statistics":"problem"/ {
+              sub(/^.*\{"statistics":"problem"/,"")
+              played = 0
+              match($0,/"moves_played_per_ply":\{[^}]*\}/)
+              n = split(substr($0,RSTART+24,RLENGTH-25),plies,",")
+              for (p = 1; p<=n; ++p)
+              {
+                split(plies[p],pair,":")
+                played += pair[2]
+              }
+              print input "," value("problem") "," value("total") "," played "," value("moves_generated") "," value("check_tests") "," value("probes") "," value("hits") "," value("tried") "," value("pruned")
+            }' >> $workdir/runs
+    done
+done
+
+# aggregate the runs of each problem
+awk -F, -v csv=$out.csv -v json=$out.json '
+    {
+      key = $1 "," $2
+      if (!(key in nr_runs))
+      {
+        keys[++nr_keys] = key
+        min[key] = $3
+        max[key] = $3
+        counters[key] = $4 "," $5 "," $6 "," $7 "," $8 "," $9 "," $10
+      }
+      ++nr_runs[key]
+      if ($3<min[key]) min[key] = $3
+      if ($3>max[key]) max[key] = $3
+    }
+    END {
+      print "input,problem,runs,time_min_ms,time_max_ms,moves_played,moves_generated,check_tests,hash_probes,hash_hits,target_positions_tried,target_positions_pruned" > csv
+      print "[" > json
+      for (k = 1; k<=nr_keys; ++k)
+      {
+        key = keys[k]
+        split(key,id,",")
+        split(counters[key],c,",")
+        print key "," nr_runs[key] "," min[key] "," max[key] "," counters[key] > csv
+        printf "  {\"input\":\"%s\",\"problem\":%s,\"runs\":%s,\"time_min_ms\":%s,\"time_max_ms\":%s,\"moves_played\":%s,\"moves_generated\":%s,\"check_tests\":%s,\"hash_probes\":%s,\"hash_hits\":%s,\"target_positions_tried\":%s,\"target_positions_pruned\":%s}%s\n",
+               id[1],id[2],nr_runs[key],min[key],max[key],c[1],c[2],c[3],c[4],c[5],c[6],c[7],
+               (k<nr_keys ? "," : "") > json
+      }
+      print "]" > json
+    }' $workdir/runs
+
+echo "results written to $out.csv and $out.json" >&2
+
+if [ -z "$baseline" ]
+then
+    exit 0
+fi
+
+# compare with the baseline
+awk -F, -v threshold=$threshold '
+    FNR==1 { next }
+    NR==FNR {
+      key = $1 "," $2
+      base_min[key] = $4
+      base_max[key] = $5
+      base_played[key] = $6
+      next
+    }
+    {
+      key = $1 "," $2
+      if (!(key in base_min))
+      {
+        printf "%-40s %s\n", $1 " " $2, "not in baseline"
+        next
+      }
+
+      noise = 10
+      if ($5-$4>noise) noise = $5-$4
+      if (base_max[key]-base_min[key]>noise) noise = base_max[key]-base_min[key]
+
+      diff = $4-base_min[key]
+      limit = base_min[key]*threshold/100
+      if (diff>limit && diff>noise)
+      {
+        verdict = "slower"
+        ++nr_slower
+      }
+      else if (-diff>limit && -diff>noise)
+      {
+        verdict = "faster"
+        ++nr_faster
+      }
+      else
+        verdict = "same"
+
+      if ($6!=base_played[key])
+        verdict = verdict " (moves played: " base_played[key] " -> " $6 ")"
+
+      printf "%-40s %8d ms %8d ms %s\n", $1 " " $2, base_min[key], $4, verdict
+
+      base_total += base_min[key]
+      total += $4
+    }
+    END {
+      printf "%-40s %8d ms %8d ms", "total", base_total, total
+      if (base_total>0)
+        printf " %+.1f%%", 100.0*(total-base_total)/base_total
+      printf "\n%d problem(s) slower, %d problem(s) faster\n", nr_slower, nr_faster
+      exit (nr_slower>0)
+    }' $baseline $out.csv
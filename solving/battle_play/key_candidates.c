@@ -0,0 +1,196 @@
+#include "solving/battle_play/key_candidates.h"
+#include "stipulation/pipe.h"
+#include "stipulation/battle_play/branch.h"
+#include "solving/workers.h"
+#include "solving/move_generator.h"
+#include "solving/machinery/slack_length.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+#include "debugging/assert.h"
+
+/* the key candidates are the moves of the move generation stack between
+ * MOVEBASE_OF_PLY(nbply) and this index; they are played from the top down */
+static numecoup first_candidate;
+
+static boolean is_worker_solving_candidates;
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void key_candidates_distributor_solve(slice_index si)
+{
+  numecoup const nr_candidates = CURRMOVE_OF_PLY(nbply)-MOVEBASE_OF_PLY(nbply);
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  first_candidate = CURRMOVE_OF_PLY(nbply);
+
+  if (nr_candidates<2)
+    pipe_solve_delegate(si);
+  else
+    switch (workers_distribute(nr_candidates))
+    {
+      case workers_distribution_in_worker:
+        is_worker_solving_candidates = true;
+        pipe_solve_delegate(si);
+        workers_end_worker(solve_result);
+        break;
+
+      case workers_distribution_in_parent:
+      {
+        /* combine the workers' results like for_each_attack_solve() combines
+         * the results of the individual moves */
+        stip_length_type result = MOVE_HAS_NOT_SOLVED_LENGTH();
+        unsigned int i;
+
+        for (i = 0; i!=workers_get_nr_workers(); ++i)
+        {
+          stip_length_type const result_worker = workers_get_result(i);
+          if (slack_length<result_worker && result_worker<result)
+            result = result_worker;
+        }
+
+        workers_end_distribution();
+
+        solve_result = result;
+        break;
+      }
+
+      case workers_distribution_failed:
+        pipe_solve_delegate(si);
+        break;
+
+      default:
+        assert(0);
+        break;
+    }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void key_candidate_claimer_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (is_worker_solving_candidates)
+  {
+    unsigned long const task = first_candidate-CURRMOVE_OF_PLY(nbply);
+    if (workers_claim_task(task))
+    {
+      pipe_solve_delegate(si);
+      workers_end_task(task);
+    }
+    else
+      /* another worker deals with this candidate */
+      solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
+  }
+  else
+    pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_distributor(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  if (st->activity==stip_traversal_activity_solving)
+  {
+    slice_index const prototypes[] =
+    {
+      alloc_pipe(STKeyCandidatesDistributor),
+      alloc_pipe(STKeyCandidateClaimer)
+    };
+    enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
+    attack_branch_insert_slices(si,prototypes,nr_prototypes);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* only the candidates of the key are distributed, i.e. we insert into the
+ * root attack branch, but not into branches nested into it (e.g. the mate of
+ * a reflex problem) or into set play */
+static structure_traversers_visitor const distributor_inserters[] =
+{
+  { STSetplayFork,    &stip_traverse_structure_children_pipe },
+  { STReadyForAttack, &insert_distributor                    },
+  { STEndOfRoot,      &stip_structure_visitor_noop           }
+};
+
+enum
+{
+  nr_distributor_inserters = (sizeof distributor_inserters
+                              / sizeof distributor_inserters[0])
+};
+
+/* Instrument the solving machinery so that the key candidates are solved by
+ * worker processes
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_distribute_key_candidates(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  TraceStipulation(si);
+
+  {
+    stip_structure_traversal st;
+    stip_structure_traversal_init(&st,0);
+    stip_structure_traversal_override_by_contextual(&st,
+                                                    slice_contextual_testing_pipe,
+                                                    &stip_traverse_structure_children_pipe);
+    stip_structure_traversal_override_by_contextual(&st,
+                                                    slice_contextual_conditional_pipe,
+                                                    &stip_traverse_structure_children_pipe);
+    stip_structure_traversal_override_by_contextual(&st,
+                                                    slice_contextual_binary,
+                                                    &stip_traverse_structure_children_pipe);
+    stip_structure_traversal_override_by_contextual(&st,
+                                                    slice_contextual_end_of_branch,
+                                                    &stip_traverse_structure_children_pipe);
+    stip_structure_traversal_override(&st,
+                                      distributor_inserters,
+                                      nr_distributor_inserters);
+    stip_traverse_structure(si,&st);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
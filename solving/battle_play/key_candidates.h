@@ -0,0 +1,46 @@
+#if !defined(SOLVING_BATTLE_PLAY_KEY_CANDIDATES_H)
+#define SOLVING_BATTLE_PLAY_KEY_CANDIDATES_H
+
+/* Distribute the solving of the key candidates of a battle play problem to
+ * worker processes (cf. solving/workers.h)
+ */
+
+#include "solving/machinery/solve.h"
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void key_candidates_distributor_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void key_candidate_claimer_solve(slice_index si);
+
+/* Instrument the solving machinery so that the key candidates are solved by
+ * worker processes
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_distribute_key_candidates(slice_index si);
+
+#endif
@@ -13,9 +13,11 @@
 #include "solving/machinery/twin.h"
 #include "solving/pipe.h"
 #include "solving/fork.h"
+#include "optimisations/king_square_attack_cache.h"
 #include "output/plaintext/message.h"
 #include "debugging/trace.h"
 #include "debugging/measure.h"
+#include "debugging/statistics.h"
 #include "debugging/assert.h"
 
 static twin_id_type is_no_king_possible;
@@ -188,6 +190,10 @@ boolean is_in_check_recursive(slice_index si, Side side_in_check)
       result = strictsat_check_tester_is_in_check(si,side_in_check);
       break;
 
+    case STKingSquareAttackCache:
+      result = king_square_attack_cache_is_in_check(si,side_in_check);
+      break;
+
     case STKingSquareObservationTesterPlyInitialiser:
       result = king_square_observation_tester_ply_initialiser_is_in_check(si,side_in_check);
       break;
@@ -212,6 +218,10 @@ boolean is_in_check_recursive(slice_index si, Side side_in_check)
       result = circe_assassin_all_piece_observation_tester_is_in_check(si,side_in_check);
       break;
 
+    case STStatisticsCheckTestCounter:
+      result = statistics_check_test_counter_is_in_check(si,side_in_check);
+      break;
+
     default:
       assert(0);
       result = false;
@@ -237,12 +247,14 @@ boolean is_in_check(Side side_in_check)
 static slice_index const slice_rank_order[] =
 {
     STTestingCheck,
+    STStatisticsCheckTestCounter,
     STNoCheckConceptCheckTester,
     STVogtlaenderCheckTester,
     STNoKingCheckTester,
     STSATCheckTester,
     STSATxyCheckTester,
     STStrictSATCheckTester,
+    STKingSquareAttackCache,
     STKingSquareObservationTesterPlyInitialiser,
     STAntikingsCheckTester,
     STKingCapturedObservationGuard,
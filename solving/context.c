@@ -0,0 +1,28 @@
+#include "solving/context.h"
+#include "debugging/trace.h"
+
+SOLVING_CONTEXT_STORAGE solving_context_type solving_context;
+
+/* Initialise the context of the current thread. To be invoked by each thread
+ * before it starts solving.
+ */
+void solving_context_init(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  nbply = ply_nil;
+
+  curr_generation = &move_generation_stack[toppile];
+
+  /* starting at 1 simplifies pointer arithmetic in undo_move_effects */
+  move_effect_journal_base[ply_nil] = 1;
+  move_effect_journal_base[ply_nil+1] = 1;
+
+  move_effect_journal_index_offset_capture = 0;
+  move_effect_journal_index_offset_movement = 1;
+  move_effect_journal_index_offset_other_effects = 2;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
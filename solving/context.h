@@ -0,0 +1,106 @@
+/* This module gathers the mutable state of solving (the position being
+ * solved, the plys, the move generation stack and the move effect journal)
+ * in a context object.
+ *
+ * There is one context per thread if the program is compiled with
+ * SOLVING_CONTEXT_PER_THREAD defined; otherwise there is one context per
+ * process. The context of the current thread is accessed using the
+ * traditional names of the variables (being_solved, nbply etc.), which are
+ * defined as macros below.
+ */
+
+/* The headers of the modules whose state is gathered here include this header
+ * at their end, and they include each other. The context is therefore only
+ * defined once all of them are complete.
+ */
+#include "position/position.h"
+#include "solving/ply.h"
+#include "solving/move_generator.h"
+#include "solving/move_effect_journal.h"
+
+#if !defined(SOLVING_CONTEXT_H) \
+    && defined(POSITION_POSITION_H_COMPLETE) \
+    && defined(SOLVING_PLY_H_COMPLETE) \
+    && defined(SOLVING_MOVE_GENERATOR_H_COMPLETE) \
+    && defined(SOLVING_MOVE_EFFECT_JOURNAL_H_COMPLETE)
+#define SOLVING_CONTEXT_H
+
+#if defined(SOLVING_CONTEXT_PER_THREAD)
+#  if defined(_MSC_VER)
+#    define SOLVING_CONTEXT_STORAGE __declspec(thread)
+#  else
+#    define SOLVING_CONTEXT_STORAGE __thread
+#  endif
+#else
+#  define SOLVING_CONTEXT_STORAGE
+#endif
+
+typedef struct
+{
+    /* position/position.c */
+    boolean areColorsSwapped;
+    boolean isBoardReflected;
+    position being_solved;
+
+    /* solving/ply.c */
+    ply nbply;
+    ply parent_ply[maxply+1];
+    Side trait[maxply+1];
+    ply ply_watermark;
+    ply ply_stack[maxply+1];
+    ply ply_stack_pointer;
+
+    /* solving/move_generator.c */
+    move_generation_elmt move_generation_stack[toppile + 1];
+    move_generation_elmt *curr_generation;
+    piece_walk_type move_generation_current_walk;
+    numecoup current_move[maxply+1];
+    numecoup current_move_id[maxply+1];
+    unsigned int square_marks[square_h8+1];
+    unsigned int current_mark;
+
+    /* solving/move_effect_journal.c */
+    move_effect_journal_entry_type move_effect_journal[move_effect_journal_size];
+    move_effect_journal_index_type move_effect_journal_base[maxply+1];
+    move_effect_journal_index_type move_effect_journal_index_offset_capture;
+    move_effect_journal_index_type move_effect_journal_index_offset_movement;
+    move_effect_journal_index_type move_effect_journal_index_offset_other_effects;
+    move_effect_journal_index_type king_square_horizon;
+#if defined(DOTRACE)
+    unsigned long move_effect_journal_next_id;
+#endif
+} solving_context_type;
+
+/* the context of the current thread */
+extern SOLVING_CONTEXT_STORAGE solving_context_type solving_context;
+
+#define areColorsSwapped (solving_context.areColorsSwapped)
+#define isBoardReflected (solving_context.isBoardReflected)
+#define being_solved (solving_context.being_solved)
+
+#define nbply (solving_context.nbply)
+#define parent_ply (solving_context.parent_ply)
+#define trait (solving_context.trait)
+
+#define move_generation_stack (solving_context.move_generation_stack)
+#define curr_generation (solving_context.curr_generation)
+#define move_generation_current_walk (solving_context.move_generation_current_walk)
+#define current_move (solving_context.current_move)
+#define current_move_id (solving_context.current_move_id)
+
+#define move_effect_journal (solving_context.move_effect_journal)
+#define move_effect_journal_base (solving_context.move_effect_journal_base)
+#define move_effect_journal_index_offset_capture (solving_context.move_effect_journal_index_offset_capture)
+#define move_effect_journal_index_offset_movement (solving_context.move_effect_journal_index_offset_movement)
+#define move_effect_journal_index_offset_other_effects (solving_context.move_effect_journal_index_offset_other_effects)
+#define king_square_horizon (solving_context.king_square_horizon)
+#if defined(DOTRACE)
+#define move_effect_journal_next_id (solving_context.move_effect_journal_next_id)
+#endif
+
+/* Initialise the context of the current thread. To be invoked by each thread
+ * before it starts solving.
+ */
+void solving_context_init(void);
+
+#endif
@@ -2,6 +2,7 @@
 #include "stipulation/branch.h"
 #include "stipulation/pipe.h"
 #include "solving/pipe.h"
+#include "solving/workers.h"
 #include "debugging/assert.h"
 #include "debugging/trace.h"
 
@@ -110,6 +111,9 @@ void phase_solving_remember_incompleteness(slice_index si,
   if (SLICE_U(SLICE_NEXT2(incomplete)).value_handler.value<c)
     SLICE_U(SLICE_NEXT2(incomplete)).value_handler.value = c;
 
+  if (workers_is_worker())
+    workers_remember_incompleteness(si,c);
+
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
@@ -135,6 +135,7 @@
 #include "conditions/transmuting_kings/reflective_kings.h"
 #include "conditions/transmuting_kings/vaulting_kings.h"
 #include "optimisations/orthodox_check_directions.h"
+#include "optimisations/orthodox_legal_moves.h"
 #include "optimisations/hash.h"
 #include "optimisations/keepmating.h"
 #include "optimisations/count_nr_opponent_moves/opponent_moves_counter.h"
@@ -162,6 +163,8 @@
 #include "optimisations/killer_move/collector.h"
 #include "optimisations/killer_move/final_defense_move.h"
 #include "optimisations/killer_move/prioriser.h"
+#include "optimisations/killer_move/history.h"
+#include "optimisations/killer_move/staged_move_generator.h"
 #include "optimisations/orthodox_mating_moves/orthodox_mating_move_generator.h"
 #include "optimisations/orthodox_mating_moves/king_contact_move_generator.h"
 #include "optimisations/orthodox_square_observation.h"
@@ -257,6 +260,7 @@
 #include "solving/battle_play/min_length_optimiser.h"
 #include "solving/battle_play/threat.h"
 #include "solving/battle_play/try.h"
+#include "solving/battle_play/key_candidates.h"
 #include "solving/battle_play/threat.h"
 #include "solving/help_play/adapter.h"
 #include "solving/boolean/or.h"
@@ -322,2062 +326,1634 @@
 #include "solving/zeroposition.h"
 #include "debugging/trace.h"
 #include "debugging/measure.h"
+#include "debugging/statistics.h"
 #include "debugging/assert.h"
 #include "platform/platform.h"
 #include "platform/maxmem.h"
 #include "platform/timer.h"
 
-/* Try to solve in solve_nr_remaining half-moves.
- * @param si slice index
- * @note assigns solve_result the length of solution found and written, i.e.:
- *            previous_move_is_illegal the move just played is illegal
- *            this_move_is_illegal     the move being played is illegal
- *            immobility_on_next_move  the moves just played led to an
- *                                     unintended immobility on the next move
- *            <=n+1 length of shortest solution found (n+1 only if in next
- *                                     branch)
- *            n+2 no solution found in this branch
- *            n+3 no solution found in next branch
- *            (with n denominating solve_nr_remaining)
- */
-void dispatch(slice_index si)
+static void true_solve(slice_index si)
 {
-  TraceEnumerator(slice_type,SLICE_TYPE(si));
-  TraceEOL();
+  solve_result = previous_move_has_solved;
+}
+
+static void false_solve(slice_index si)
+{
+  solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
+}
 
-  switch (SLICE_TYPE(si))
+static void generate_moves_for_piece_based_on_walk_solve(slice_index si)
+{
+  generate_moves_for_piece_based_on_walk();
+}
+
+static void is_square_observed_ortho_solve(slice_index si)
+{
+  observation_result = is_square_observed_ortho(trait[nbply],
+                                                move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture);
+}
+
+/* Find the function that solves slices of a type
+ * @param type slice type
+ * @return the function
+ */
+static slice_solver_type find_solver(slice_type type)
+{
+  switch (type)
   {
     case STQuodlibetStipulationModifier:
-      quodlibet_stipulation_modifier_solve(si);
-      break;
+      return &quodlibet_stipulation_modifier_solve;
 
     case STGoalIsEndStipulationModifier:
-      goal_is_end_stipulation_modifier_solve(si);
-      break;
+      return &goal_is_end_stipulation_modifier_solve;
 
     case STWhiteToPlayStipulationModifier:
-      white_to_play_stipulation_modifier_solve(si);
-      break;
+      return &white_to_play_stipulation_modifier_solve;
 
     case STPostKeyPlayStipulationModifier:
-      post_key_play_stipulation_modifier_solve(si);
-      break;
+      return &post_key_play_stipulation_modifier_solve;
 
     case STStipulationStarterDetector:
-      stipulation_starter_detector_solve(si);
-      break;
+      return &stipulation_starter_detector_solve;
 
     case STStipulationCopier:
-      stipulation_copier_solve(si);
-      break;
+      return &stipulation_copier_solve;
 
     case STProofSolverBuilder:
-      build_proof_solving_machinery(si);
-      break;
+      return &build_proof_solving_machinery;
 
     case STAToBSolverBuilder:
-      build_atob_solving_machinery(si);
-      break;
+      return &build_atob_solving_machinery;
 
     case STTwinIdAdjuster:
-      twin_id_adjuster_solve(si);
-      break;
+      return &twin_id_adjuster_solve;
 
     case STConditionsResetter:
-      conditions_resetter_solve(si);
-      break;
+      return &conditions_resetter_solve;
 
     case STOptionsResetter:
-      options_resetter_solve(si);
-      break;
+      return &options_resetter_solve;
 
     case STProblemSolvingIncomplete:
-      problem_solving_incomplete_solve(si);
-      break;
+      return &problem_solving_incomplete_solve;
 
     case STPhaseSolvingIncomplete:
-      phase_solving_incomplete_solve(si);
-      break;
+      return &phase_solving_incomplete_solve;
 
     case STCommandLineOptionsParser:
-      command_line_options_parser_solve(si);
-      break;
+      return &command_line_options_parser_solve;
 
     case STInputPlainTextOpener:
-      input_plaintext_opener_solve(si);
-      break;
+      return &input_plaintext_opener_solve;
 
     case STPlatformInitialiser:
-      platform_initialiser_solve(si);
-      break;
+      return &platform_initialiser_solve;
 
     case STOutputLaTeXCloser:
-      output_latex_closer_solve(si);
-      break;
+      return &output_latex_closer_solve;
 
     case STOutputPlainTextInstrumentSolversBuilder:
-      output_plaintext_instrument_solving_builder_solve(si);
-      break;
+      return &output_plaintext_instrument_solving_builder_solve;
 
     case STOutputPlainTextInstrumentSolvers:
-      output_plaintext_instrument_solving(si);
-      break;
+      return &output_plaintext_instrument_solving;
 
     case STOutputLaTeXInstrumentSolversBuilder:
-      output_latex_instrument_solving_builder_solve(si);
-      break;
+      return &output_latex_instrument_solving_builder_solve;
 
     case STOutputLaTeXInstrumentSolvers:
-      output_latex_instrument_solving(si);
-      break;
+      return &output_latex_instrument_solving;
 
     case STHashTableDimensioner:
-      hashtable_dimensioner_solve(si);
-      break;
+      return &hashtable_dimensioner_solve;
 
     case STTimerStarter:
-      timer_starter_solve(si);
-      break;
+      return &timer_starter_solve;
 
     case STCheckDirInitialiser:
-      check_dir_initialiser_solve(si);
-      break;
+      return &check_dir_initialiser_solve;
 
     case STOutputPlainTextWriter:
-      output_plaintext_writer_solve(si);
-      break;
+      return &output_plaintext_writer_solve;
 
     case STInputPlainTextUserLanguageDetector:
-      input_plaintext_detect_user_language(si);
-      break;
+      return &input_plaintext_detect_user_language;
 
     case STInputPlainTextProblemsIterator:
-      input_plaintext_iterate_problems(si);
-      break;
+      return &input_plaintext_iterate_problems;
 
     case STEndOfStipulationSpecific:
     case STOutputPlainTextStartOfTargetWriter:
-      pipe_solve_delegate(si);
-      break;
+      return &pipe_solve_delegate;
 
     case STInputPlainTextProblemHandler:
-      input_plaintext_problem_handle(si);
-      break;
+      return &input_plaintext_problem_handle;
 
     case STInputPlainTextInitialTwinReader:
-      input_plaintext_initial_twin_reader_solve(si);
-      break;
+      return &input_plaintext_initial_twin_reader_solve;
 
     case STInputPlainTextTwinsHandler:
-      input_plaintext_twins_handle(si);
-      break;
+      return &input_plaintext_twins_handle;
 
     case STSolvingMachineryIntroBuilder:
-      solving_machinery_intro_builder_solve(si);
-      break;
+      return &solving_machinery_intro_builder_solve;
 
     case STOutputPlainTextOptionNoboard:
-      output_plaintext_option_noboard_solve(si);
-      break;
+      return &output_plaintext_option_noboard_solve;
 
     case STOutputPlaintextTwinIntroWriterBuilder:
-      output_plaintext_twin_intro_writer_builder_solve(si);
-      break;
+      return &output_plaintext_twin_intro_writer_builder_solve;
 
     case STOutputLaTeXTwinningWriterBuilder:
-      output_latex_twinning_writer_builder_solve(si);
-      break;
+      return &output_latex_twinning_writer_builder_solve;
 
     case STStartOfCurrentTwin:
-      slices_deallocator_solve(si);
-      break;
+      return &slices_deallocator_solve;
 
     case STDuplexSolver:
-      duplex_solve(si);
-      break;
+      return &duplex_solve;
 
     case STHalfDuplexSolver:
-      half_duplex_solve(si);
-      break;
+      return &half_duplex_solve;
 
     case STCreateBuilderSetupPly:
-      create_builder_setup_ply_solve(si);
-      break;
+      return &create_builder_setup_ply_solve;
 
     case STPieceWalkCacheInitialiser:
-      piece_walk_caches_initialiser_solve(si);
-      break;
+      return &piece_walk_caches_initialiser_solve;
 
     case STPiecesCounter:
     {
       void pieces_counter_solve(slice_index si);
-      pieces_counter_solve(si);
-      break;
+      return &pieces_counter_solve;
     }
 
     case STPiecesFlagsInitialiser:
     {
       void initialise_piece_flags_solve(slice_index si);
-      initialise_piece_flags_solve(si);
-      break;
+      return &initialise_piece_flags_solve;
     }
 
     case STRoyalsLocator:
     {
       void royals_locator_solve(slice_index si);
-      royals_locator_solve(si);
-      break;
+      return &royals_locator_solve;
     }
 
     case STProofgameVerifyUniqueGoal:
-      proof_verify_unique_goal_solve(si);
-      break;
+      return &proof_verify_unique_goal_solve;
 
     case STProofgameStartPositionInitialiser:
-      proof_initialise_start_position(si);
-      break;
+      return &proof_initialise_start_position;
 
     case STProofSolver:
-      proof_solve(si);
-      break;
+      return &proof_solve;
 
     case STInputVerification:
     {
       void verify_position(slice_index si);
-      verify_position(si);
-      break;
+      return &verify_position;
     }
 
     case STMoveEffectsJournalReset:
-      move_effect_journal_reset(si);
-      break;
+      return &move_effect_journal_reset;
 
     case STSolversBuilder1:
-      build_solvers1(si);
-      break;
+      return &build_solvers1;
 
     case STSolversBuilder2:
-      build_solvers2(si);
-      break;
+      return &build_solvers2;
 
     case STProxyResolver:
-      proxies_resolve(si);
-      break;
+      return &proxies_resolve;
 
     case STSlackLengthAdjuster:
-      adjust_slack_length(si);
-      break;
+      return &adjust_slack_length;
 
     case STThreatSolver:
-      threat_solver_solve(si);
-      break;
+      return &threat_solver_solve;
 
     case STDummyMove:
-      dummy_move_solve(si);
-      break;
+      return &dummy_move_solve;
 
     case STThreatCollector:
-      threat_collector_solve(si);
-      break;
+      return &threat_collector_solve;
 
     case STThreatEnforcer:
-      threat_enforcer_solve(si);
-      break;
+      return &threat_enforcer_solve;
 
     case STThreatDefeatedTester:
-      threat_defeated_tester_solve(si);
-      break;
+      return &threat_defeated_tester_solve;
 
     case STOutputPlainTextThreatWriter:
-      output_plaintext_tree_threat_writer_solve(si);
-      break;
+      return &output_plaintext_tree_threat_writer_solve;
 
     case STOutputPlainTextZugzwangWriter:
-      output_plaintext_tree_zugzwang_writer_solve(si);
-      break;
+      return &output_plaintext_tree_zugzwang_writer_solve;
 
     case STOutputPlainTextKeyWriter:
-      output_plaintext_tree_key_writer_solve(si);
-      break;
+      return &output_plaintext_tree_key_writer_solve;
 
     case STOutputPlainTextTryWriter:
-      output_plaintext_tree_try_writer_solve(si);
-      break;
+      return &output_plaintext_tree_try_writer_solve;
 
     case STRefutationsAllocator:
-      refutations_allocator_solve(si);
-      break;
+      return &refutations_allocator_solve;
 
     case STRefutationsSolver:
-      refutations_solver_solve(si);
-      break;
+      return &refutations_solver_solve;
 
     case STOutputPlainTextRefutationsIntroWriter:
-      output_plaintext_tree_refutations_intro_writer_solve(si);
-      break;
+      return &output_plaintext_tree_refutations_intro_writer_solve;
 
     case STRefutationsAvoider:
-      refutations_avoider_solve(si);
-      break;
+      return &refutations_avoider_solve;
 
     case STRefutationsFilter:
-      refutations_filter_solve(si);
-      break;
+      return &refutations_filter_solve;
 
     case STOutputPlaintextTreeRefutingVariationWriter:
-      output_plaintext_tree_refuting_variation_writer_solve(si);
-      break;
+      return &output_plaintext_tree_refuting_variation_writer_solve;
 
     case STOutputPlaintextLineRefutingVariationWriter:
-      output_plaintext_line_refuting_variation_writer_solve(si);
-      break;
+      return &output_plaintext_line_refuting_variation_writer_solve;
 
     case STOutputPlainTextMoveWriter:
-      output_plaintext_tree_move_writer_solve(si);
-      break;
+      return &output_plaintext_tree_move_writer_solve;
 
     case STTrivialEndFilter:
-      trivial_end_filter_solve(si);
-      break;
+      return &trivial_end_filter_solve;
 
     case STNoShortVariations:
-      no_short_variations_solve(si);
-      break;
+      return &no_short_variations_solve;
 
     case STOr:
-      or_solve(si);
-      break;
+      return &or_solve;
 
     case STFindShortest:
-      find_shortest_solve(si);
-      break;
+      return &find_shortest_solve;
 
     case STMoveGenerator:
-      move_generator_solve(si);
-      break;
+      return &move_generator_solve;
 
     case STForEachAttack:
-      for_each_attack_solve(si);
-      break;
+      return &for_each_attack_solve;
 
     case STFindAttack:
-      find_attack_solve(si);
-      break;
+      return &find_attack_solve;
 
     case STForEachDefense:
-      for_each_defense_solve(si);
-      break;
+      return &for_each_defense_solve;
 
     case STFindDefense:
-      find_defense_solve(si);
-      break;
+      return &find_defense_solve;
 
     case STNullMovePlayer:
-      null_move_player_solve(si);
-      break;
+      return &null_move_player_solve;
 
     case STPostMoveIterationInitialiser:
-      move_execution_post_move_iterator_solve(si);
-      break;
+      return &move_execution_post_move_iterator_solve;
 
     case STMoveEffectJournalUndoer:
-      move_effect_journal_undoer_solve(si);
-      break;
+      return &move_effect_journal_undoer_solve;
 
     case STMessignyMovePlayer:
-      messigny_move_player_solve(si);
-      break;
+      return &messigny_move_player_solve;
 
     case STCastlingPlayer:
-      castling_player_solve(si);
-      break;
+      return &castling_player_solve;
 
     case STMovePlayer:
-      move_player_solve(si);
-      break;
+      return &move_player_solve;
 
     case STEnPassantAdjuster:
-      en_passant_adjuster_solve(si);
-      break;
+      return &en_passant_adjuster_solve;
 
     case STEinsteinEnPassantAdjuster:
-      einstein_en_passant_adjuster_solve(si);
-      break;
+      return &einstein_en_passant_adjuster_solve;
 
     case STPawnPromoter:
-      pawn_promoter_solve(si);
-      break;
+      return &pawn_promoter_solve;
 
     case STMarsCirceMoveToRebirthSquare:
-      marscirce_move_to_rebirth_square_solve(si);
-      break;
+      return &marscirce_move_to_rebirth_square_solve;
 
     case STKamikazeCapturingPieceRemover:
-      kamikaze_capturing_piece_remover_solve(si);
-      break;
+      return &kamikaze_capturing_piece_remover_solve;
 
     case STHaanChessHoleInserter:
-      haan_chess_hole_inserter_solve(si);
-      break;
+      return &haan_chess_hole_inserter_solve;
 
     case STCastlingChessMovePlayer:
-      castling_chess_move_player_solve(si);
-      break;
+      return &castling_chess_move_player_solve;
 
     case STExchangeCastlingMovePlayer:
-      exchange_castling_move_player_solve(si);
-      break;
+      return &exchange_castling_move_player_solve;
 
     case STSuperTransmutingKingTransmuter:
-      supertransmuting_kings_transmuter_solve(si);
-      break;
+      return &supertransmuting_kings_transmuter_solve;
 
     case STSuperTransmutingKingMoveGenerationFilter:
-      supertransmuting_kings_move_generation_filter_solve(si);
-      break;
+      return &supertransmuting_kings_move_generation_filter_solve;
 
     case STAMUAttackCounter:
-      amu_attack_counter_solve(si);
-      break;
+      return &amu_attack_counter_solve;
 
     case STMutualCastlingRightsAdjuster:
-      mutual_castling_rights_adjuster_solve(si);
-      break;
+      return &mutual_castling_rights_adjuster_solve;
 
     case STImitatorMover:
-      imitator_mover_solve(si);
-      break;
+      return &imitator_mover_solve;
 
     case STImitatorRemoveIllegalMoves:
-      imitator_remove_illegal_moves_solve(si);
-      break;
+      return &imitator_remove_illegal_moves_solve;
 
     case STImitatorDetectIllegalMoves:
-      imitator_detect_illegal_moves_solve(si);
-      break;
+      return &imitator_detect_illegal_moves_solve;
 
     case STPawnToImitatorPromoter:
-      imitator_pawn_promoter_solve(si);
-      break;
+      return &imitator_pawn_promoter_solve;
 
     case STAttackPlayed:
-      attack_played_solve(si);
-      break;
+      return &attack_played_solve;
 
 #if defined(DOTRACE)
     case STMoveTracer:
-      move_tracer_solve(si);
-      break;
+      return &move_tracer_solve;
 #endif
 
 #if defined(DOMEASURE)
     case STMoveCounter:
-      move_counter_solve(si);
-      break;
+      return &move_counter_solve;
 
     case STCountersWriter:
-      counters_writer_solve(si);
-      break;
+      return &counters_writer_solve;
 #endif
 
+    case STStatisticsWriter:
+      return &statistics_writer_solve;
+
+    case STStatisticsMoveCounter:
+      return &statistics_move_counter_solve;
+
+    case STStatisticsMoveGenerationCounter:
+      return &statistics_move_generation_counter_solve;
+
+    case STStatisticsSetplayTimer:
+      return &statistics_setplay_timer_solve;
+
+    case STStatisticsLengthCounter:
+      return &statistics_length_counter_solve;
+
+    case STStatisticsTargetPositionCandidateCounter:
+      return &statistics_target_position_candidate_counter_solve;
+
+    case STStatisticsTargetPositionCounter:
+      return &statistics_target_position_counter_solve;
+
     case STOrthodoxMatingMoveGenerator:
-      orthodox_mating_move_generator_solve(si);
-      break;
+      return &orthodox_mating_move_generator_solve;
 
     case STOrthodoxMatingKingContactGenerator:
-      orthodox_mating_king_contact_generator_solve(si);
-      break;
+      return &orthodox_mating_king_contact_generator_solve;
 
     case STDeadEnd:
     case STDeadEndGoal:
-      dead_end_solve(si);
-      break;
+      return &dead_end_solve;
 
     case STMinLengthOptimiser:
-      min_length_optimiser_solve(si);
-      break;
+      return &min_length_optimiser_solve;
 
     case STForkOnRemaining:
-      fork_on_remaining_solve(si);
-      break;
+      return &fork_on_remaining_solve;
 
     case STHashOpener:
-      hash_opener_solve(si);
-      break;
+      return &hash_opener_solve;
 
     case STAttackHashed:
-      attack_hashed_solve(si);
-      break;
+      return &attack_hashed_solve;
 
     case STAttackHashedTester:
-      attack_hashed_tester_solve(si);
-      break;
+      return &attack_hashed_tester_solve;
 
     case STHelpHashed:
-      help_hashed_solve(si);
-      break;
+      return &help_hashed_solve;
 
     case STHelpHashedTester:
-      help_hashed_tester_solve(si);
-      break;
+      return &help_hashed_tester_solve;
 
     case STEndOfBranch:
     case STEndOfBranchForced:
     case STEndOfBranchTester:
-      end_of_branch_solve(si);
-      break;
+      return &end_of_branch_solve;
 
     case STEndOfBranchGoal:
     case STEndOfBranchGoalImmobile:
     case STEndOfBranchGoalTester:
-      end_of_branch_goal_solve(si);
-      break;
+      return &end_of_branch_goal_solve;
 
     case STGoalReachedTester:
-      goal_reached_tester_solve(si);
-      break;
+      return &goal_reached_tester_solve;
 
     case STAvoidUnsolvable:
-      avoid_unsolvable_solve(si);
-      break;
+      return &avoid_unsolvable_solve;
 
     case STResetUnsolvable:
-      reset_unsolvable_solve(si);
-      break;
+      return &reset_unsolvable_solve;
 
     case STLearnUnsolvable:
-      learn_unsolvable_solve(si);
-      break;
+      return &learn_unsolvable_solve;
 
     case STConstraintSolver:
     case STConstraintTester:
     case STGoalConstraintTester:
-      constraint_solve(si);
-      break;
+      return &constraint_solve;
 
     case STSelfCheckGuard:
     case STExclusiveChessGoalReachingMoveCounterSelfCheckGuard:
-      selfcheck_guard_solve(si);
-      break;
+      return &selfcheck_guard_solve;
 
     case STKeepMatingFilter:
-      keepmating_filter_solve(si);
-      break;
+      return &keepmating_filter_solve;
 
     case STOutputPlaintextTreeCheckWriter:
-      output_plaintext_tree_check_writer_solve(si);
-      break;
+      return &output_plaintext_tree_check_writer_solve;
 
     case STOutputPlainTextRefutationWriter:
-      output_plaintext_tree_refutation_writer_solve(si);
-      break;
+      return &output_plaintext_tree_refutation_writer_solve;
 
     case STDoubleMateFilter:
-      doublemate_filter_solve(si);
-      break;
+      return &doublemate_filter_solve;
 
     case STCounterMateFilter:
-      countermate_filter_solve(si);
-      break;
+      return &countermate_filter_solve;
 
     case STEnPassantFilter:
-      enpassant_filter_solve(si);
-      break;
+      return &enpassant_filter_solve;
 
     case STEnPassantRemoveNonReachers:
-      enpassant_remove_non_reachers_solve(si);
-      break;
+      return &enpassant_remove_non_reachers_solve;
 
     case STCastlingFilter:
-      castling_filter_solve(si);
-      break;
+      return &castling_filter_solve;
 
     case STCastlingRemoveNonReachers:
-      castling_remove_non_reachers_solve(si);
-      break;
+      return &castling_remove_non_reachers_solve;
 
     case STPrerequisiteOptimiser:
-      goal_prerequisite_optimiser_solve(si);
-      break;
+      return &goal_prerequisite_optimiser_solve;
 
     case STChess81RemoveNonReachers:
-      chess81_remove_non_reachers_solve(si);
-      break;
+      return &chess81_remove_non_reachers_solve;
 
     case STCaptureRemoveNonReachers:
-      capture_remove_non_reachers_solve(si);
-      break;
+      return &capture_remove_non_reachers_solve;
 
     case STTargetRemoveNonReachers:
-      target_remove_non_reachers_solve(si);
-      break;
+      return &target_remove_non_reachers_solve;
 
     case STDetectMoveRetracted:
-      detect_move_retracted_solve(si);
-      break;
+      return &detect_move_retracted_solve;
 
     case STRetractionPrioriser:
-      priorise_retraction_solve(si);
-      break;
+      return &priorise_retraction_solve;
 
     case STOutputPlaintextProblemWriter:
-      output_plaintext_problem_writer_solve(si);
-      break;
+      return &output_plaintext_problem_writer_solve;
 
     case STOutputPlaintextGoalWriter:
-      output_plaintext_goal_writer_solve(si);
-      break;
+      return &output_plaintext_goal_writer_solve;
 
     case STOutputPlaintextLineLineWriter:
-      output_plaintext_line_line_writer_solve(si);
-      break;
+      return &output_plaintext_line_line_writer_solve;
 
     case STOutputLaTeXGoalWriter:
-      output_latex_goal_writer_solve(si);
-      break;
+      return &output_latex_goal_writer_solve;
 
     case STOutputLaTeXLineLineWriter:
-      output_latex_line_line_writer_solve(si);
-      break;
+      return &output_latex_line_line_writer_solve;
 
     case STOutputLaTeXProblemWriter:
-      output_latex_problem_writer_solve(si);
-      break;
+      return &output_latex_problem_writer_solve;
 
     case STOutputLaTeXProblemIntroWriter:
-      output_latex_problem_intro_writer_solve(si);
-      break;
+      return &output_latex_problem_intro_writer_solve;
 
     case STOutputLaTeXTwinningWriter:
-      output_latex_write_twinning(si);
-      break;
+      return &output_latex_write_twinning;
 
     case STOutputLaTeXTreeEndOfSolutionWriter:
-      output_latex_tree_end_of_solution_writer_solve(si);
-      break;
+      return &output_latex_tree_end_of_solution_writer_solve;
 
     case STOutputLaTeXKeyWriter:
-      output_latex_tree_key_writer_solve(si);
-      break;
+      return &output_latex_tree_key_writer_solve;
 
     case STOutputLaTeXMoveWriter:
-      output_latex_tree_move_writer_solve(si);
-      break;
+      return &output_latex_tree_move_writer_solve;
 
     case STOutputLaTeXRefutationWriter:
-      output_latex_tree_refutation_writer_solve(si);
-      break;
+      return &output_latex_tree_refutation_writer_solve;
 
     case STOutputLaTeXThreatWriter:
-      output_latex_tree_threat_writer_solve(si);
-      break;
+      return &output_latex_tree_threat_writer_solve;
 
     case STOutputLaTeXTreeCheckWriter:
-      output_latex_tree_check_writer_solve(si);
-      break;
+      return &output_latex_tree_check_writer_solve;
 
     case STOutputLaTeXTreeRefutingVariationWriter:
-      output_latex_tree_refuting_variation_writer_solve(si);
-      break;
+      return &output_latex_tree_refuting_variation_writer_solve;
 
     case STOutputLaTeXTryWriter:
-      output_latex_tree_try_writer_solve(si);
-      break;
+      return &output_latex_tree_try_writer_solve;
 
     case STOutputLaTeXZugzwangWriter:
-      output_latex_tree_zugzwang_writer_solve(si);
-      break;
+      return &output_latex_tree_zugzwang_writer_solve;
 
     case STBGLEnforcer:
-      bgl_enforcer_solve(si);
-      break;
+      return &bgl_enforcer_solve;
 
     case STBGLAdjuster:
-      bgl_adjuster_solve(si);
-      break;
+      return &bgl_adjuster_solve;
 
     case STMasandRecolorer:
-      masand_recolorer_solve(si);
-      break;
+      return &masand_recolorer_solve;
 
     case STActuatedRevolvingCentre:
-      actuated_revolving_centre_solve(si);
-      break;
+      return &actuated_revolving_centre_solve;
 
     case STActuatedRevolvingBoard:
-      actuated_revolving_board_solve(si);
-      break;
+      return &actuated_revolving_board_solve;
 
     case STRepublicanKingPlacer:
-      republican_king_placer_solve(si);
-      break;
+      return &republican_king_placer_solve;
 
     case STRepublicanType1DeadEnd:
-      republican_type1_dead_end_solve(si);
-      break;
+      return &republican_type1_dead_end_solve;
 
     case STCirceCaptureFork:
-      circe_capture_fork_solve(si);
-      break;
+      return &circe_capture_fork_solve;
 
     case STCircePreventKingRebirth:
-      circe_prevent_king_rebirth_solve(si);
-      break;
+      return &circe_prevent_king_rebirth_solve;
 
     case STCirceInitialiseRelevantFromReborn:
-      circe_initialise_relevant_from_reborn(si);
-      break;
+      return &circe_initialise_relevant_from_reborn;
 
     case STCirceInitialiseFromCurrentMove:
-      circe_make_current_move_relevant_solve(si);
-      break;
+      return &circe_make_current_move_relevant_solve;
 
     case STCirceInitialiseFromLastMove:
-      circe_make_last_move_relevant_solve(si);
-      break;
+      return &circe_make_last_move_relevant_solve;
 
     case STCirceInitialiseRebornFromCapturee:
-      circe_initialise_reborn_from_capturee_solve(si);
-      break;
+      return &circe_initialise_reborn_from_capturee_solve;
 
     case STCirceCloneDetermineRebornWalk:
-      circe_clone_determine_reborn_walk_solve(si);
-      break;
+      return &circe_clone_determine_reborn_walk_solve;
 
     case STAntiCloneCirceDetermineRebornWalk:
-      anti_clone_circe_determine_reborn_walk_solve(si);
-      break;
+      return &anti_clone_circe_determine_reborn_walk_solve;
 
     case STCirceDoubleAgentsAdaptRebornSide:
-      circe_doubleagents_adapt_reborn_side_solve(si);
-      break;
+      return &circe_doubleagents_adapt_reborn_side_solve;
 
     case STChameleonCirceAdaptRebornWalk:
-      chameleon_circe_adapt_reborn_walk_solve(si);
-      break;
+      return &chameleon_circe_adapt_reborn_walk_solve;
 
     case STCirceEinsteinAdjustRebornWalk:
-      circe_einstein_adjust_reborn_walk_solve(si);
-      break;
+      return &circe_einstein_adjust_reborn_walk_solve;
 
     case STCirceReverseEinsteinAdjustRebornWalk:
-      circe_reverse_einstein_adjust_reborn_walk_solve(si);
-      break;
+      return &circe_reverse_einstein_adjust_reborn_walk_solve;
 
     case STCirceCouscousMakeCapturerRelevant:
-      circe_couscous_make_capturer_relevant_solve(si);
-      break;
+      return &circe_couscous_make_capturer_relevant_solve;
 
     case STAnticirceCouscousMakeCaptureeRelevant:
-      anticirce_couscous_make_capturee_relevant_solve(si);
-      break;
+      return &anticirce_couscous_make_capturee_relevant_solve;
 
     case STMirrorCirceOverrideRelevantSide:
-      mirror_circe_override_relevant_side_solve(si);
-      break;
+      return &mirror_circe_override_relevant_side_solve;
 
     case STCirceDetermineRebirthSquare:
-      circe_determine_rebirth_square_solve(si);
-      break;
+      return &circe_determine_rebirth_square_solve;
 
     case STCirceFrischaufAdjustRebirthSquare:
-      frischauf_adjust_rebirth_square_solve(si);
-      break;
+      return &frischauf_adjust_rebirth_square_solve;
 
     case STCirceGlasgowAdjustRebirthSquare:
-      circe_glasgow_adjust_rebirth_square_solve(si);
-      break;
+      return &circe_glasgow_adjust_rebirth_square_solve;
 
     case STFileCirceDetermineRebirthSquare:
-      file_circe_determine_rebirth_square_solve(si);
-      break;
+      return &file_circe_determine_rebirth_square_solve;
 
     case STCirceDiametralAdjustRebirthSquare:
-      circe_diametral_adjust_rebirth_square_solve(si);
-      break;
+      return &circe_diametral_adjust_rebirth_square_solve;
 
     case STCirceVerticalMirrorAdjustRebirthSquare:
-      circe_verticalmirror_adjust_rebirth_square_solve(si);
-      break;
+      return &circe_verticalmirror_adjust_rebirth_square_solve;
 
     case STRankCirceOverrideRelevantSide:
-      rank_circe_override_relevant_side_solve(si);
-      break;
+      return &rank_circe_override_relevant_side_solve;
 
     case STRankCirceProjectRebirthSquare:
-      rank_circe_adjust_rebirth_square_solve(si);
-      break;
+      return &rank_circe_adjust_rebirth_square_solve;
 
     case STTakeMakeCirceDetermineRebirthSquares:
-      take_make_circe_determine_rebirth_squares_solve(si);
-      break;
+      return &take_make_circe_determine_rebirth_squares_solve;
 
     case STTakeMakeCirceCollectRebirthSquares:
-      take_make_circe_collect_rebirth_squares_solve(si);
-      break;
+      return &take_make_circe_collect_rebirth_squares_solve;
 
     case STAntipodesCirceDetermineRebirthSquare:
-      antipodes_circe_determine_rebirth_square_solve(si);
-      break;
+      return &antipodes_circe_determine_rebirth_square_solve;
 
     case STSymmetryCirceDetermineRebirthSquare:
-      symmetry_circe_determine_rebirth_square_solve(si);
-      break;
+      return &symmetry_circe_determine_rebirth_square_solve;
 
     case STPWCDetermineRebirthSquare:
-      pwc_determine_rebirth_square_solve(si);
-      break;
+      return &pwc_determine_rebirth_square_solve;
 
     case STDiagramCirceDetermineRebirthSquare:
-      diagram_circe_determine_rebirth_square_solve(si);
-      break;
+      return &diagram_circe_determine_rebirth_square_solve;
 
     case STContactGridAvoidCirceRebirth:
-      contact_grid_avoid_circe_rebirth(si);
-      break;
+      return &contact_grid_avoid_circe_rebirth;
 
     case STGenevaStopCaptureFromRebirthSquare:
-      geneva_stop_catpure_from_rebirth_square_solve(si);
-      break;
+      return &geneva_stop_catpure_from_rebirth_square_solve;
 
     case STCirceTestRebirthSquareEmpty:
-      circe_test_rebirth_square_empty_solve(si);
-      break;
+      return &circe_test_rebirth_square_empty_solve;
 
     case STCircePlaceReborn:
-      circe_place_reborn_solve(si);
-      break;
+      return &circe_place_reborn_solve;
 
     case STCirceDoneWithRebirth:
-      circe_done_with_rebirth(si);
-      break;
+      return &circe_done_with_rebirth;
 
     case STAprilCaptureFork:
-      april_chess_fork_solve(si);
-      break;
+      return &april_chess_fork_solve;
 
     case STSuperCirceNoRebirthFork:
-      supercirce_no_rebirth_fork_solve(si);
-      break;
+      return &supercirce_no_rebirth_fork_solve;
 
     case STSuperCirceDetermineRebirthSquare:
-      supercirce_determine_rebirth_square_solve(si);
-      break;
+      return &supercirce_determine_rebirth_square_solve;
 
     case STSupercircePreventRebirthOnNonEmptySquare:
-      supercirce_prevent_rebirth_on_non_empty_square_solve(si);
-      break;
+      return &supercirce_prevent_rebirth_on_non_empty_square_solve;
 
     case STCirceVolageRecolorer:
-      circe_volage_recolorer_solve(si);
-      break;
+      return &circe_volage_recolorer_solve;
 
     case STCirceParrainThreatFork:
-      circe_parrain_threat_fork_solve(si);
-      break;
+      return &circe_parrain_threat_fork_solve;
 
     case STCirceParrainDetermineRebirth:
-      circe_parrain_determine_rebirth_solve(si);
-      break;
+      return &circe_parrain_determine_rebirth_solve;
 
     case STCirceContraparrainDetermineRebirth:
-      circe_contraparrain_determine_rebirth_solve(si);
-      break;
+      return &circe_contraparrain_determine_rebirth_solve;
 
     case STCirceCageNoCageFork:
-      circe_cage_no_cage_fork_solve(si);
-      break;
+      return &circe_cage_no_cage_fork_solve;
 
     case STCirceCageCageTester:
-      circe_cage_cage_tester_solve(si);
-      break;
+      return &circe_cage_cage_tester_solve;
 
     case STCageCirceFutileCapturesRemover:
-      circe_cage_futile_captures_remover_solve(si);
-      break;
+      return &circe_cage_futile_captures_remover_solve;
 
     case STSentinellesInserter:
-      sentinelles_inserter_solve(si);
-      break;
+      return &sentinelles_inserter_solve;
 
     case STMagicViewsInitialiser:
-      magic_views_initialiser_solve(si);
-      break;
+      return &magic_views_initialiser_solve;
 
     case STMagicPiecesRecolorer:
-      magic_pieces_recolorer_solve(si);
-      break;
+      return &magic_pieces_recolorer_solve;
 
     case STHauntedChessGhostSummoner:
-      haunted_chess_ghost_summoner_solve(si);
-      break;
+      return &haunted_chess_ghost_summoner_solve;
 
     case STHauntedChessGhostRememberer:
-      haunted_chess_ghost_rememberer_solve(si);
-      break;
+      return &haunted_chess_ghost_rememberer_solve;
 
     case STGhostChessGhostRememberer:
-      ghost_chess_ghost_rememberer_solve(si);
-      break;
+      return &ghost_chess_ghost_rememberer_solve;
 
     case STAndernachSideChanger:
-      andernach_side_changer_solve(si);
-      break;
+      return &andernach_side_changer_solve;
 
     case STAntiAndernachSideChanger:
-      antiandernach_side_changer_solve(si);
-      break;
+      return &antiandernach_side_changer_solve;
 
     case STChameleonPursuitSideChanger:
-      chameleon_pursuit_side_changer_solve(si);
-      break;
+      return &chameleon_pursuit_side_changer_solve;
 
     case STNorskRemoveIllegalCaptures:
-      norsk_remove_illegal_captures_solve(si);
-      break;
+      return &norsk_remove_illegal_captures_solve;
 
     case STNorskArrivingAdjuster:
-      norsk_arriving_adjuster_solve(si);
-      break;
+      return &norsk_arriving_adjuster_solve;
 
     case STProteanPawnAdjuster:
-      protean_pawn_adjuster_solve(si);
-      break;
+      return &protean_pawn_adjuster_solve;
 
     case STEinsteinArrivingAdjuster:
-      einstein_moving_adjuster_solve(si);
-      break;
+      return &einstein_moving_adjuster_solve;
 
     case STReverseEinsteinArrivingAdjuster:
-      reverse_einstein_moving_adjuster_solve(si);
-      break;
+      return &reverse_einstein_moving_adjuster_solve;
 
     case STAntiEinsteinArrivingAdjuster:
-      anti_einstein_moving_adjuster_solve(si);
-      break;
+      return &anti_einstein_moving_adjuster_solve;
 
     case STTraitorSideChanger:
-      traitor_side_changer_solve(si);
-      break;
+      return &traitor_side_changer_solve;
 
     case STVolageSideChanger:
-      volage_side_changer_solve(si);
-      break;
+      return &volage_side_changer_solve;
 
     case STMagicSquareSideChanger:
     case STMagicSquareType2SideChanger:
-      magic_square_side_changer_solve(si);
-      break;
+      return &magic_square_side_changer_solve;
 
     case STMagicSquareType2AnticirceRelevantSideAdapter:
-      magic_square_anticirce_relevant_side_adapter_solve(si);
-      break;
+      return &magic_square_anticirce_relevant_side_adapter_solve;
 
     case STTibetSideChanger:
-      tibet_solve(si);
-      break;
+      return &tibet_solve;
 
     case STDoubleTibetSideChanger:
-      double_tibet_solve(si);
-      break;
+      return &double_tibet_solve;
 
     case STDegradierungDegrader:
-      degradierung_degrader_solve(si);
-      break;
+      return &degradierung_degrader_solve;
 
     case STChameleonChangePromoteeInto:
-      chameleon_change_promotee_into_solve(si);
-      break;
+      return &chameleon_change_promotee_into_solve;
 
     case STChameleonArrivingAdjuster:
-      chameleon_arriving_adjuster_solve(si);
-      break;
+      return &chameleon_arriving_adjuster_solve;
 
     case STChameleonChessArrivingAdjuster:
-      chameleon_chess_arriving_adjuster_solve(si);
-      break;
+      return &chameleon_chess_arriving_adjuster_solve;
 
     case STLineChameleonArrivingAdjuster:
-      line_chameleon_arriving_adjuster_solve(si);
-      break;
+      return &line_chameleon_arriving_adjuster_solve;
 
     case STFrischaufPromoteeMarker:
-      frischauf_promotee_marker_solve(si);
-      break;
+      return &frischauf_promotee_marker_solve;
 
     case STPiecesHalfNeutralRecolorer:
-      half_neutral_recolorer_solve(si);
-      break;
+      return &half_neutral_recolorer_solve;
 
     case STKobulKingSubstitutor:
-      kobul_king_substitutor_solve(si);
-      break;
+      return &kobul_king_substitutor_solve;
 
     case STSnekSubstitutor:
-      snek_substitutor_solve(si);
-      break;
+      return &snek_substitutor_solve;
 
     case STSnekCircleSubstitutor:
-      snek_circle_substitutor_solve(si);
-      break;
+      return &snek_circle_substitutor_solve;
 
     case STDuellistsRememberDuellist:
-      duellists_remember_duellist_solve(si);
-      break;
+      return &duellists_remember_duellist_solve;
 
     case STSingleboxType2LatentPawnSelector:
-      singlebox_type2_latent_pawn_selector_solve(si);
-      break;
+      return &singlebox_type2_latent_pawn_selector_solve;
 
     case STSingleboxType2LatentPawnPromoter:
-      singlebox_type2_latent_pawn_promoter_solve(si);
-      break;
+      return &singlebox_type2_latent_pawn_promoter_solve;
 
     case STCirceKamikazeCaptureFork:
-      circe_kamikaze_capture_fork_solve(si);
-      break;
+      return &circe_kamikaze_capture_fork_solve;
 
     case STAnticirceInitialiseRebornFromCapturer:
-      circe_initialise_reborn_from_capturer_solve(si);
-      break;
+      return &circe_initialise_reborn_from_capturer_solve;
 
     case STMarscirceInitialiseRebornFromGenerated:
-      marscirce_initialise_reborn_from_generated_solve(si);
-      break;
+      return &marscirce_initialise_reborn_from_generated_solve;
 
     case STGenevaInitialiseRebornFromCapturer:
-      geneva_initialise_reborn_from_capturer_solve(si);
-      break;
+      return &geneva_initialise_reborn_from_capturer_solve;
 
     case STAnticirceCheylanFilter:
-      anticirce_cheylan_filter_solve(si);
-      break;
+      return &anticirce_cheylan_filter_solve;
 
     case STAnticirceRemoveCapturer:
-      anticirce_remove_capturer_solve(si);
-      break;
+      return &anticirce_remove_capturer_solve;
 
     case STMarscirceRemoveCapturer:
-      marscirce_remove_capturer_solve(si);
-      break;
+      return &marscirce_remove_capturer_solve;
 
     case STFootballChessSubsitutor:
-      football_chess_substitutor_solve(si);
-      break;
+      return &football_chess_substitutor_solve;
 
     case STRefutationsCollector:
-      refutations_collector_solve(si);
-      break;
+      return &refutations_collector_solve;
 
     case STMinLengthGuard:
-      min_length_guard_solve(si);
-      break;
+      return &min_length_guard_solve;
 
     case STDegenerateTree:
-      degenerate_tree_solve(si);
-      break;
+      return &degenerate_tree_solve;
 
     case STMaxNrNonTrivialCounter:
-      max_nr_nontrivial_counter_solve(si);
-      break;
+      return &max_nr_nontrivial_counter_solve;
 
     case STKillerDefenseCollector:
-      killer_defense_collector_solve(si);
-      break;
+      return &killer_defense_collector_solve;
 
     case STFindByIncreasingLength:
-      find_by_increasing_length_solve(si);
-      break;
+      return &find_by_increasing_length_solve;
 
     case STHelpMovePlayed:
-      help_move_played_solve(si);
-      break;
+      return &help_move_played_solve;
 
     case STIntelligentMovesLeftInitialiser:
-      intelligent_moves_left_initialiser_solve(si);
-      break;
+      return &intelligent_moves_left_initialiser_solve;
 
     case STRestartGuardIntelligent:
-      restart_guard_intelligent_solve(si);
-      break;
+      return &restart_guard_intelligent_solve;
 
     case STIntelligentTargetCounter:
-      intelligent_target_counter_solve(si);
-      break;
+      return &intelligent_target_counter_solve;
 
     case STIntelligentFilter:
-      intelligent_filter_solve(si);
-      break;
+      return &intelligent_filter_solve;
 
     case STIntelligentFlightsGuarder:
-      intelligent_guard_flights(si);
-      break;
+      return &intelligent_guard_flights;
 
     case STIntelligentFlightsBlocker:
-      intelligent_find_and_block_flights(si);
-      break;
+      return &intelligent_find_and_block_flights;
 
     case STIntelligentMateTargetPositionTester:
-      intelligent_mate_test_target_position(si);
-      break;
+      return &intelligent_mate_test_target_position;
 
     case STIntelligentStalemateTargetPositionTester:
-      intelligent_stalemate_test_target_position(si);
-      break;
+      return &intelligent_stalemate_test_target_position;
 
     case STIntelligentProof:
-      intelligent_proof_solve(si);
-      break;
+      return &intelligent_proof_solve;
 
     case STIntelligentLimitNrSolutionsPerTargetPosLimiter:
-      intelligent_limit_nr_solutions_per_target_position_solve(si);
-      break;
+      return &intelligent_limit_nr_solutions_per_target_position_solve;
 
     case STGoalReachableGuardFilterMate:
-      goalreachable_guard_mate_solve(si);
-      break;
+      return &goalreachable_guard_mate_solve;
 
     case STGoalReachableGuardFilterStalemate:
-      goalreachable_guard_stalemate_solve(si);
-      break;
+      return &goalreachable_guard_stalemate_solve;
 
     case STGoalReachableGuardFilterProof:
-      goalreachable_guard_proofgame_solve(si);
-      break;
+      return &goalreachable_guard_proofgame_solve;
 
     case STGoalReachableGuardFilterProofFairy:
-      goalreachable_guard_proofgame_fairy_solve(si);
-      break;
+      return &goalreachable_guard_proofgame_fairy_solve;
 
     case STRestartGuard:
-      restart_guard_solve(si);
-      break;
+      return &restart_guard_solve;
 
     case STRestartGuardNested:
-      restart_guard_nested_solve(si);
-      break;
+      return &restart_guard_nested_solve;
 
     case STMaxTimeProblemInstrumenter:
-      maxtime_problem_instrumenter_solve(si);
-      break;
+      return &maxtime_problem_instrumenter_solve;
 
     case STMaxTimeSetter:
-      maxtime_set(si);
-      break;
+      return &maxtime_set;
 
     case STMaxTimeGuard:
-      maxtime_guard_solve(si);
-      break;
+      return &maxtime_guard_solve;
+
+    case STKeyCandidatesDistributor:
+      return &key_candidates_distributor_solve;
+
+    case STKeyCandidateClaimer:
+      return &key_candidate_claimer_solve;
 
     case STMaxSolutionsProblemInstrumenter:
-      maxsolutions_problem_instrumenter_solve(si);
-      break;
+      return &maxsolutions_problem_instrumenter_solve;
 
     case STMaxSolutionsSolvingInstrumenter:
-      maxsolutions_solving_instrumenter_solve(si);
-      break;
+      return &maxsolutions_solving_instrumenter_solve;
 
     case STMaxSolutionsCounter:
-      maxsolutions_counter_solve(si);
-      break;
+      return &maxsolutions_counter_solve;
 
     case STMaxSolutionsGuard:
-      maxsolutions_guard_solve(si);
-      break;
+      return &maxsolutions_guard_solve;
 
     case STStopOnShortSolutionsSolvingInstrumenter:
-      stoponshortsolutions_solving_instrumenter_solve(si);
-      break;
+      return &stoponshortsolutions_solving_instrumenter_solve;
 
     case STStopOnShortSolutionsFilter:
-      stoponshortsolutions_solve(si);
-      break;
+      return &stoponshortsolutions_solve;
 
     case STIfThenElse:
-      if_then_else_solve(si);
-      break;
+      return &if_then_else_solve;
 
     case STFlightsquaresCounter:
-      flightsquares_counter_solve(si);
-      break;
+      return &flightsquares_counter_solve;
 
     case STKingMoveGenerator:
-      king_move_generator_solve(si);
-      break;
+      return &king_move_generator_solve;
 
     case STNonKingMoveGenerator:
-      non_king_move_generator_solve(si);
-      break;
+      return &non_king_move_generator_solve;
 
     case STUltraMummerMeasurerDeadend:
-      ultra_mummer_measurer_deadend_solve(si);
-      break;
+      return &ultra_mummer_measurer_deadend_solve;
 
     case STLegalAttackCounter:
     case STAnyMoveCounter:
-      legal_attack_counter_solve(si);
-      break;
+      return &legal_attack_counter_solve;
 
     case STLegalDefenseCounter:
-      legal_defense_counter_solve(si);
-      break;
+      return &legal_defense_counter_solve;
 
     case STCaptureCounter:
-      capture_counter_solve(si);
-      break;
+      return &capture_counter_solve;
 
     case STOhneschachStopIfCheck:
-      ohneschach_stop_if_check_solve(si);
-      break;
+      return &ohneschach_stop_if_check_solve;
 
     case STOhneschachStopIfCheckAndNotMate:
-      ohneschach_stop_if_check_and_not_mate_solve(si);
-      break;
+      return &ohneschach_stop_if_check_and_not_mate_solve;
 
     case STOhneschachDetectUndecidableGoal:
-      ohneschach_detect_undecidable_goal_solve(si);
-      break;
+      return &ohneschach_detect_undecidable_goal_solve;
 
     case STRecursionStopper:
-      recursion_stopper_solve(si);
-      break;
+      return &recursion_stopper_solve;
 
     case STSinglePieceMoveGenerator:
-      single_piece_move_generator_solve(si);
-      break;
+      return &single_piece_move_generator_solve;
 
     case STCastlingRightsAdjuster:
-      castling_rights_adjuster_solve(si);
-      break;
+      return &castling_rights_adjuster_solve;
 
     case STOpponentMovesCounter:
-      opponent_moves_counter_solve(si);
-      break;
+      return &opponent_moves_counter_solve;
 
     case STOpponentMovesFewMovesPrioriser:
-      opponent_moves_few_moves_prioriser_solve(si);
-      break;
+      return &opponent_moves_few_moves_prioriser_solve;
 
     case STIntelligentImmobilisationCounter:
-      intelligent_immobilisation_counter_solve(si);
-      break;
+      return &intelligent_immobilisation_counter_solve;
 
     case STIntelligentDuplicateAvoider:
-      intelligent_duplicate_avoider_solve(si);
-      break;
+      return &intelligent_duplicate_avoider_solve;
 
     case STIntelligentSolutionRememberer:
-      intelligent_solution_rememberer_solve(si);
-      break;
+      return &intelligent_solution_rememberer_solve;
 
     case STIntelligentSolutionsPerTargetPosProblemInstrumenter:
-      intelligent_nr_solutions_per_target_position_problem_instrumenter_solve(si);
-      break;
+      return &intelligent_nr_solutions_per_target_position_problem_instrumenter_solve;
 
     case STIntelligentSolutionsPerTargetPosSolvingInstrumenter:
-      intelligent_nr_solutions_per_target_position_solving_instrumenter_solve(si);
-      break;
+      return &intelligent_nr_solutions_per_target_position_solving_instrumenter_solve;
 
     case STIntelligentSolutionsPerTargetPosInitialiser:
-      intelligent_nr_solutions_per_target_position_initialiser_solve(si);
-      break;
+      return &intelligent_nr_solutions_per_target_position_initialiser_solve;
 
     case STIntelligentSolutionsPerTargetPosCounter:
-      intelligent_nr_solutions_per_target_position_counter_solve(si);
-      break;
+      return &intelligent_nr_solutions_per_target_position_counter_solve;
 
     case STSetplayFork:
-      setplay_fork_solve(si);
-      break;
+      return &setplay_fork_solve;
 
     case STAttackAdapter:
-      attack_adapter_solve(si);
-      break;
+      return &attack_adapter_solve;
 
     case STDefenseAdapter:
-      defense_adapter_solve(si);
-      break;
+      return &defense_adapter_solve;
 
     case STHelpAdapter:
-      help_adapter_solve(si);
-      break;
+      return &help_adapter_solve;
 
     case STAnd:
-      and_solve(si);
-      break;
+      return &and_solve;
 
     case STNot:
-      not_solve(si);
-      break;
+      return &not_solve;
 
     case STMoveInverter:
     case STMoveInverterSetPlay:
-      move_inverter_solve(si);
-      break;
+      return &move_inverter_solve;
 
     case STRetroStartRetractionPly:
-      retro_start_retraction_ply(si);
-      break;
+      return &retro_start_retraction_ply;
 
     case STRetroPlayNullMove:
-      retro_play_null_move(si);
-      break;
+      return &retro_play_null_move;
 
     case STRetroRetractLastCapture:
-      circe_parrain_undo_retro_capture(si);
-      break;
+      return &circe_parrain_undo_retro_capture;
 
     case STRetroRedoLastCapture:
-      circe_parrain_redo_retro_capture(si);
-      break;
+      return &circe_parrain_redo_retro_capture;
 
     case STRetroUndoLastPawnMultistep:
-      en_passant_undo_multistep(si);
-      break;
+      return &en_passant_undo_multistep;
 
     case STRetroRedoLastPawnMultistep:
-      en_passant_redo_multistep(si);
-      break;
+      return &en_passant_redo_multistep;
 
     case STRetroStartRetroMovePly:
-      retro_start_retro_move_ply(si);
-      break;
+      return &retro_start_retro_move_ply;
 
     case STMaxSolutionsInitialiser:
-      maxsolutions_initialiser_solve(si);
-      break;
+      return &maxsolutions_initialiser_solve;
 
     case STStopOnShortSolutionsProblemInstrumenter:
-      stoponshortsolutions_problem_instrumenter_solve(si);
-      break;
+      return &stoponshortsolutions_problem_instrumenter_solve;
 
     case STStopOnShortSolutionsWasShortSolutionFound:
-      stoponshortsolutions_was_short_solution_found_solve(si);
-      break;
+      return &stoponshortsolutions_was_short_solution_found_solve;
 
     case STOutputPlaintextZeropositionIntroWriter:
-      output_plaintext_write_zeroposition_intro(si);
-      break;
+      return &output_plaintext_write_zeroposition_intro;
 
     case STOutputPlaintextTwinIntroWriter:
-      output_plaintext_write_twin_intro(si);
-      break;
+      return &output_plaintext_write_twin_intro;
 
     case STOutputPlainTextMetaWriter:
-      output_plaintext_write_meta(si);
-      break;
+      return &output_plaintext_write_meta;
 
     case STOutputPlainTextBoardWriter:
-      output_plaintext_write_board(si);
-      break;
+      return &output_plaintext_write_board;
 
     case STOutputPlainTextPieceCountsWriter:
-      output_plaintext_write_piece_counts(si);
-      break;
+      return &output_plaintext_write_piece_counts;
 
     case STOutputPlainTextRoyalPiecePositionsWriter:
-      output_plaintext_write_royal_piece_positions(si);
-      break;
+      return &output_plaintext_write_royal_piece_positions;
 
     case STOutputPlainTextNonRoyalAttributesWriter:
-      output_plaintext_write_non_royal_attributes(si);
-      break;
+      return &output_plaintext_write_non_royal_attributes;
 
     case STOutputPlainTextConditionsWriter:
-      output_plaintext_write_conditions(si);
-      break;
+      return &output_plaintext_write_conditions;
 
     case STOutputPlainTextMutuallyExclusiveCastlingsWriter:
-      output_plaintext_write_mutually_exclusive_castlings(si);
-      break;
+      return &output_plaintext_write_mutually_exclusive_castlings;
 
     case STOutputPlainTextDuplexWriter:
-      output_plaintext_write_duplex(si);
-      break;
+      return &output_plaintext_write_duplex;
 
     case STOutputPlainTextHalfDuplexWriter:
-      output_plaintext_write_halfduplex(si);
-      break;
+      return &output_plaintext_write_halfduplex;
 
     case STOutputPlainTextQuodlibetWriter:
-      output_plaintext_write_quodlibet(si);
-      break;
+      return &output_plaintext_write_quodlibet;
 
     case STOutputPlainTextAToBIntraWriter:
-      output_plaintext_write_atob_intra(si);
-      break;
+      return &output_plaintext_write_atob_intra;
 
     case STOutputPlainTextStipulationWriter:
-      output_plaintext_write_stipulation(si);
-      break;
+      return &output_plaintext_write_stipulation;
 
     case STOutputPlainTextGridWriter:
-      output_plaintext_write_grid(si);
-      break;
+      return &output_plaintext_write_grid;
 
     case STOutputPlainTextEndOfPositionWriters:
-      output_plaintext_end_of_position_writers_solve(si);
-      break;
+      return &output_plaintext_end_of_position_writers_solve;
 
     case STZeroPositionInitialiser:
-      zeroposition_initialiser_solve(si);
-      break;
+      return &zeroposition_initialiser_solve;
 
     case STZeropositionSolvingStopper:
-      zeroposition_solving_stopper_solve(si);
-      break;
+      return &zeroposition_solving_stopper_solve;
 
     case STIllegalSelfcheckWriter:
-      illegal_selfcheck_writer_solve(si);
-      break;
+      return &illegal_selfcheck_writer_solve;
 
     case STOutputPlainTextEndOfPhaseWriter:
-      output_plaintext_end_of_phase_writer_solve(si);
-      break;
+      return &output_plaintext_end_of_phase_writer_solve;
 
     case STOutputPlaintextMoveInversionCounter:
     case STOutputPlaintextMoveInversionCounterSetPlay:
-      output_plaintext_move_inversion_counter_solve(si);
-      break;
+      return &output_plaintext_move_inversion_counter_solve;
 
     case STOutputPlaintextLineEndOfIntroSeriesMarker:
-      output_plaintext_line_end_of_intro_series_marker_solve(si);
-      break;
+      return &output_plaintext_line_end_of_intro_series_marker_solve;
 
     case STPiecesParalysingMateFilter:
-      paralysing_mate_filter_solve(si);
-      break;
+      return &paralysing_mate_filter_solve;
 
     case STPiecesParalysingStalemateSpecial:
-      paralysing_stalemate_special_solve(si);
-      break;
+      return &paralysing_stalemate_special_solve;
 
     case STPiecesParalysingRemoveCaptures:
-      paralysing_remove_captures_solve(si);
-      break;
+      return &paralysing_remove_captures_solve;
 
     case STPiecesParalysingSuffocationFinder:
-      paralysing_suffocation_finder_solve(si);
-      break;
+      return &paralysing_suffocation_finder_solve;
 
     case STAmuMateFilter:
-      amu_mate_filter_solve(si);
-      break;
+      return &amu_mate_filter_solve;
 
     case STCirceSteingewinnFilter:
-      circe_steingewinn_filter_solve(si);
-      break;
+      return &circe_steingewinn_filter_solve;
 
     case STCirceCircuitSpecial:
-      circe_circuit_special_solve(si);
-      break;
+      return &circe_circuit_special_solve;
 
     case STCirceExchangeSpecial:
-      circe_exchange_special_solve(si);
-      break;
+      return &circe_exchange_special_solve;
 
     case STTemporaryHackFork:
-      pipe_solve_delegate(si);
-      break;
+      return &pipe_solve_delegate;
 
     case STGoalTargetReachedTester:
-      goal_target_reached_tester_solve(si);
-      break;
+      return &goal_target_reached_tester_solve;
 
     case STGoalCheckReachedTester:
-      goal_check_reached_tester_solve(si);
-      break;
+      return &goal_check_reached_tester_solve;
 
     case STGoalCaptureReachedTester:
-      goal_capture_reached_tester_solve(si);
-      break;
+      return &goal_capture_reached_tester_solve;
 
     case STGoalSteingewinnReachedTester:
-      goal_steingewinn_reached_tester_solve(si);
-      break;
+      return &goal_steingewinn_reached_tester_solve;
 
     case STGoalEnpassantReachedTester:
-      goal_enpassant_reached_tester_solve(si);
-      break;
+      return &goal_enpassant_reached_tester_solve;
 
     case STGoalDoubleMateReachedTester:
-      goal_doublemate_reached_tester_solve(si);
-      break;
+      return &goal_doublemate_reached_tester_solve;
 
     case STGoalCounterMateReachedTester:
-      goal_countermate_reached_tester_solve(si);
-      break;
+      return &goal_countermate_reached_tester_solve;
 
     case STGoalCastlingReachedTester:
-      goal_castling_reached_tester_solve(si);
-      break;
+      return &goal_castling_reached_tester_solve;
 
     case STGoalCircuitReachedTester:
-      goal_circuit_reached_tester_solve(si);
-      break;
+      return &goal_circuit_reached_tester_solve;
 
     case STGoalExchangeReachedTester:
-      goal_exchange_reached_tester_solve(si);
-      break;
+      return &goal_exchange_reached_tester_solve;
 
     case STGoalCircuitByRebirthReachedTester:
-      goal_circuit_by_rebirth_reached_tester_solve(si);
-      break;
+      return &goal_circuit_by_rebirth_reached_tester_solve;
 
     case STGoalExchangeByRebirthReachedTester:
-      goal_exchange_by_rebirth_reached_tester_solve(si);
-      break;
+      return &goal_exchange_by_rebirth_reached_tester_solve;
 
     case STGoalProofgameReachedTester:
     case STGoalAToBReachedTester:
-      goal_proofgame_reached_tester_solve(si);
-      break;
+      return &goal_proofgame_reached_tester_solve;
 
     case STGoalImmobileReachedTester:
-      goal_immobile_reached_tester_solve(si);
-      break;
+      return &goal_immobile_reached_tester_solve;
 
     case STMaffImmobilityTesterKing:
-      maff_immobility_tester_king_solve(si);
-      break;
+      return &maff_immobility_tester_king_solve;
 
     case STOWUImmobilityTesterKing:
-      owu_immobility_tester_king_solve(si);
-      break;
+      return &owu_immobility_tester_king_solve;
 
     case STGoalNotCheckReachedTester:
-      goal_notcheck_reached_tester_solve(si);
-      break;
+      return &goal_notcheck_reached_tester_solve;
 
     case STGoalAnyReachedTester:
-      goal_any_reached_tester_solve(si);
-      break;
+      return &goal_any_reached_tester_solve;
 
     case STGoalChess81ReachedTester:
-      goal_chess81_reached_tester_solve(si);
-      break;
+      return &goal_chess81_reached_tester_solve;
 
     case STGoalKissReachedTester:
-      goal_kiss_reached_tester_solve(si);
-      break;
+      return &goal_kiss_reached_tester_solve;
 
     case STGoalKingCaptureReachedTester:
-      goal_king_capture_reached_tester_solve(si);
-      break;
+      return &goal_king_capture_reached_tester_solve;
 
     case STPiecesParalysingMateFilterTester:
-      paralysing_mate_filter_tester_solve(si);
-      break;
+      return &paralysing_mate_filter_tester_solve;
 
     case STBlackChecks:
-      blackchecks_solve(si);
-      break;
+      return &blackchecks_solve;
 
     case STSingleBoxType1LegalityTester:
-      singlebox_type1_legality_tester_solve(si);
-      break;
+      return &singlebox_type1_legality_tester_solve;
 
     case STSingleBoxType2LegalityTester:
-      singlebox_type2_legality_tester_solve(si);
-      break;
+      return &singlebox_type2_legality_tester_solve;
 
     case STSingleBoxType3LegalityTester:
-      singlebox_type3_legality_tester_solve(si);
-      break;
+      return &singlebox_type3_legality_tester_solve;
 
     case STSingleBoxType3PawnPromoter:
-      singlebox_type3_pawn_promoter_solve(si);
-      break;
+      return &singlebox_type3_pawn_promoter_solve;
 
     case STExclusiveChessExclusivityDetector:
-      exclusive_chess_exclusivity_detector_solve(si);
-      break;
+      return &exclusive_chess_exclusivity_detector_solve;
 
     case STExclusiveChessNestedExclusivityDetector:
-      exclusive_chess_nested_exclusivity_detector_solve(si);
-      break;
+      return &exclusive_chess_nested_exclusivity_detector_solve;
 
     case STExclusiveChessLegalityTester:
-      exclusive_chess_legality_tester_solve(si);
-      break;
+      return &exclusive_chess_legality_tester_solve;
 
     case STExclusiveChessGoalReachingMoveCounter:
-      exclusive_chess_goal_reaching_move_counter_solve(si);
-      break;
+      return &exclusive_chess_goal_reaching_move_counter_solve;
 
     case STExclusiveChessUndecidableWriterTree:
-      exclusive_chess_undecidable_writer_tree_solve(si);
-      break;
+      return &exclusive_chess_undecidable_writer_tree_solve;
 
     case STExclusiveChessUndecidableWriterLine:
-      exclusive_chess_undecidable_writer_line_solve(si);
-      break;
+      return &exclusive_chess_undecidable_writer_line_solve;
 
     case STUltraschachzwangLegalityTester:
-      ultraschachzwang_legality_tester_solve(si);
-      break;
+      return &ultraschachzwang_legality_tester_solve;
 
     case STIsardamLegalityTester:
-      isardam_legality_tester_solve(si);
-      break;
+      return &isardam_legality_tester_solve;
 
     case STCirceAssassinAssassinate:
-      circe_assassin_assassinate_solve(si);
-      break;
+      return &circe_assassin_assassinate_solve;
 
     case STCirceParachuteRemember:
-      circe_parachute_remember_solve(si);
-      break;
+      return &circe_parachute_remember_solve;
 
     case STCirceParachuteUncoverer:
-      circe_parachute_uncoverer_solve(si);
-      break;
+      return &circe_parachute_uncoverer_solve;
 
     case STCirceVolcanicRemember:
-      circe_volcanic_remember_solve(si);
-      break;
+      return &circe_volcanic_remember_solve;
 
     case STCirceVolcanicSwapper:
-      circe_volcanic_swapper_solve(si);
-      break;
+      return &circe_volcanic_swapper_solve;
 
     case STKingSquareUpdater:
-      king_square_updater_solve(si);
-      break;
+      return &king_square_updater_solve;
 
     case STOwnKingCaptureAvoider:
-      own_king_capture_avoider_solve(si);
-      break;
+      return &own_king_capture_avoider_solve;
 
     case STOpponentKingCaptureAvoider:
-      opponent_king_capture_avoider_solve(si);
-      break;
+      return &opponent_king_capture_avoider_solve;
 
     case STPatienceChessLegalityTester:
-      patience_chess_legality_tester_solve(si);
-      break;
+      return &patience_chess_legality_tester_solve;
 
     case STStrictSATInitialiser:
-      strict_sat_initialiser_solve(si);
-      break;
+      return &strict_sat_initialiser_solve;
 
     case STStrictSATUpdater:
-      strict_sat_updater_solve(si);
-      break;
+      return &strict_sat_updater_solve;
 
     case STDynastyKingSquareUpdater:
-      dynasty_king_square_updater_solve(si);
-      break;
+      return &dynasty_king_square_updater_solve;
 
     case STHurdleColourChanger:
-      hurdle_colour_changer_solve(si);
-      break;
+      return &hurdle_colour_changer_solve;
 
     case STHurdleColourChangeInitialiser:
-      hurdle_colour_change_initialiser_solve(si);
-      break;
+      return &hurdle_colour_change_initialiser_solve;
 
     case STHurdleColourChangerChangePromoteeInto:
-      hurdle_colour_change_change_promotee_into_solve(si);
-      break;
+      return &hurdle_colour_change_change_promotee_into_solve;
 
     case STOscillatingKingsTypeA:
-      oscillating_kings_type_a_solve(si);
-      break;
+      return &oscillating_kings_type_a_solve;
 
     case STOscillatingKingsTypeB:
-      oscillating_kings_type_b_solve(si);
-      break;
+      return &oscillating_kings_type_b_solve;
 
     case STOscillatingKingsTypeC:
-      oscillating_kings_type_c_solve(si);
-      break;
+      return &oscillating_kings_type_c_solve;
 
     case STPlaySuppressor:
-      play_suppressor_solve(si);
-      break;
+      return &play_suppressor_solve;
 
     case STContinuationSolver:
-      continuation_solver_solve(si);
-      break;
+      return &continuation_solver_solve;
 
     case STDefensePlayed:
-      defense_played_solve(si);
-      break;
+      return &defense_played_solve;
 
     case STMaxFlightsquares:
-      maxflight_guard_solve(si);
-      break;
+      return &maxflight_guard_solve;
 
     case STMaxNrNonTrivial:
-      max_nr_nontrivial_guard_solve(si);
-      break;
+      return &max_nr_nontrivial_guard_solve;
 
     case STOutputPlainTextTreeEndOfSolutionWriter:
-      output_plaintext_end_of_solution_writer_solve(si);
-      break;
+      return &output_plaintext_end_of_solution_writer_solve;
 
     case STKillerMoveFinalDefenseMove:
-      killer_move_final_defense_move_solve(si);
-      break;
+      return &killer_move_final_defense_move_solve;
 
     case STKillerMovePrioriser:
-      killer_move_prioriser_solve(si);
-      break;
+      return &killer_move_prioriser_solve;
+
+    case STHistoryMovePrioriser:
+      return &history_move_prioriser_solve;
+
+    case STStagedMoveGenerator:
+      return &staged_move_generator_solve;
 
     case STMaxThreatLength:
-      maxthreatlength_guard_solve(si);
-      break;
+      return &maxthreatlength_guard_solve;
 
     case STKillerAttackCollector:
-      killer_attack_collector_solve(si);
-      break;
+      return &killer_attack_collector_solve;
 
     case STMummerOrchestrator:
-      mummer_orchestrator_solve(si);
-      break;
+      return &mummer_orchestrator_solve;
 
     case STMummerBookkeeper:
-      mummer_bookkeeper_solve(si);
-      break;
+      return &mummer_bookkeeper_solve;
 
     case STBackHomeMovesOnly:
-      back_home_moves_only_solve(si);
-      break;
+      return &back_home_moves_only_solve;
 
     case STNoPromotionsRemovePromotionMoving:
-      nopromotion_avoid_promotion_moving_solve(si);
-      break;
+      return &nopromotion_avoid_promotion_moving_solve;
 
     case STBackhomeExistanceTester:
-      backhome_existance_tester_solve(si);
-      break;
+      return &backhome_existance_tester_solve;
 
     case STBackhomeRemoveIllegalMoves:
-      backhome_remove_illegal_moves_solve(si);
-      break;
+      return &backhome_remove_illegal_moves_solve;
 
     case STNocaptureRemoveCaptures:
-      nocapture_remove_captures_solve(si);
-      break;
+      return &nocapture_remove_captures_solve;
+
+    case STOrthodoxRemoveIllegalMoves:
+      return &orthodox_remove_illegal_moves_solve;
 
     case STWoozlesRemoveIllegalCaptures:
-      woozles_remove_illegal_captures_solve(si);
-      break;
+      return &woozles_remove_illegal_captures_solve;
 
     case STBiWoozlesRemoveIllegalCaptures:
-      biwoozles_remove_illegal_captures_solve(si);
-      break;
+      return &biwoozles_remove_illegal_captures_solve;
 
     case STHeffalumpsRemoveIllegalCaptures:
-      heffalumps_remove_illegal_captures_solve(si);
-      break;
+      return &heffalumps_remove_illegal_captures_solve;
 
     case STBiHeffalumpsRemoveIllegalCaptures:
-      biheffalumps_remove_illegal_captures_solve(si);
-      break;
+      return &biheffalumps_remove_illegal_captures_solve;
 
     case STProvocateursRemoveUnobservedCaptures:
-      provocateurs_remove_unobserved_captures_solve(si);
-      break;
+      return &provocateurs_remove_unobserved_captures_solve;
 
     case STLortapRemoveSupportedCaptures:
-      lortap_remove_supported_captures_solve(si);
-      break;
+      return &lortap_remove_supported_captures_solve;
 
     case STPatrolRemoveUnsupportedCaptures:
-      patrol_remove_unsupported_captures_solve(si);
-      break;
+      return &patrol_remove_unsupported_captures_solve;
 
     case STKoekoLegalityTester:
-      koeko_legality_tester_solve(si);
-      break;
+      return &koeko_legality_tester_solve;
 
     case STGridContactLegalityTester:
-      contact_grid_legality_tester_solve(si);
-      break;
+      return &contact_grid_legality_tester_solve;
 
     case STAntiKoekoLegalityTester:
-      antikoeko_legality_tester_solve(si);
-      break;
+      return &antikoeko_legality_tester_solve;
 
     case STNewKoekoRememberContact:
-      newkoeko_remember_contact_solve(si);
-      break;
+      return &newkoeko_remember_contact_solve;
 
     case STNewKoekoLegalityTester:
-      newkoeko_legality_tester_solve(si);
-      break;
+      return &newkoeko_legality_tester_solve;
 
     case STJiggerLegalityTester:
-      jigger_legality_tester_solve(si);
-      break;
+      return &jigger_legality_tester_solve;
 
     case STMonochromeRemoveBichromeMoves:
-      monochrome_remove_bichrome_moves_solve(si);
-      break;
+      return &monochrome_remove_bichrome_moves_solve;
 
     case STBichromeRemoveMonochromeMoves:
-      bichrome_remove_monochrome_moves_solve(si);
-      break;
+      return &bichrome_remove_monochrome_moves_solve;
 
     case STEdgeMoverRemoveIllegalMoves:
-      edgemover_remove_illegal_moves_solve(si);
-      break;
+      return &edgemover_remove_illegal_moves_solve;
 
     case STShieldedKingsRemoveIllegalCaptures:
-      shielded_kings_remove_illegal_captures_solve(si);
-      break;
+      return &shielded_kings_remove_illegal_captures_solve;
 
     case STSuperguardsRemoveIllegalCaptures:
-      superguards_remove_illegal_captures_solve(si);
-      break;
+      return &superguards_remove_illegal_captures_solve;
 
     case STGridRemoveIllegalMoves:
-      grid_remove_illegal_moves_solve(si);
-      break;
+      return &grid_remove_illegal_moves_solve;
 
     case STUncapturableRemoveCaptures:
-      uncapturable_remove_captures_solve(si);
-      break;
+      return &uncapturable_remove_captures_solve;
 
     case STTakeAndMakeGenerateMake:
-      take_and_make_generate_make_solve(si);
-      break;
+      return &take_and_make_generate_make_solve;
 
     case STTakeAndMakeAvoidPawnMakeToBaseLine:
-      take_and_make_avoid_pawn_make_to_base_line_solve(si);
-      break;
+      return &take_and_make_avoid_pawn_make_to_base_line_solve;
 
     case STWormholeRemoveIllegalCaptures:
-      wormhole_remove_illegal_captures_solve(si);
-      break;
+      return &wormhole_remove_illegal_captures_solve;
 
     case STWormholeTransferer:
-      wormhole_transferer_solve(si);
-      break;
+      return &wormhole_transferer_solve;
 
     case STExtinctionExtinctedTester:
-      extinction_extincted_tester_solve(si);
-      break;
+      return &extinction_extincted_tester_solve;
 
     case STCastlingGeneratorTestDeparture:
-      castling_generate_test_departure(si);
-      break;
+      return &castling_generate_test_departure;
 
     case STBlackChecksNullMoveGenerator:
-      black_checks_null_move_generator_solve(si);
-      break;
+      return &black_checks_null_move_generator_solve;
 
     case STTrue:
-      solve_result = previous_move_has_solved;
-      break;
+      return &true_solve;
 
     case STFalse:
-      solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
-      break;
+      return &false_solve;
 
     /* move generators: */
     case STSingleBoxType3TMovesForPieceGenerator:
-      singleboxtype3_generate_moves_for_piece(si);
-      break;
+      return &singleboxtype3_generate_moves_for_piece;
 
     case STMadrasiMovesForPieceGenerator:
-      madrasi_generate_moves_for_piece(si);
-      break;
+      return &madrasi_generate_moves_for_piece;
 
     case STEiffelMovesForPieceGenerator:
-      eiffel_generate_moves_for_piece(si);
-      break;
+      return &eiffel_generate_moves_for_piece;
 
     case STDisparateMovesForPieceGenerator:
-      disparate_generate_moves_for_piece(si);
-      break;
+      return &disparate_generate_moves_for_piece;
 
     case STParalysingMovesForPieceGenerator:
-      paralysing_generate_moves_for_piece(si);
-      break;
+      return &paralysing_generate_moves_for_piece;
 
     case STUltraPatrolMovesForPieceGenerator:
-      ultrapatrol_generate_moves_for_piece(si);
-      break;
+      return &ultrapatrol_generate_moves_for_piece;
 
     case STCentralMovesForPieceGenerator:
-      central_generate_moves_for_piece(si);
-      break;
+      return &central_generate_moves_for_piece;
 
     case STBeamtenMovesForPieceGenerator:
-      beamten_generate_moves_for_piece(si);
-      break;
+      return &beamten_generate_moves_for_piece;
 
     case STMarsCirceMoveGeneratorEnforceRexInclusive:
-      marscirce_generate_moves_enforce_rex_exclusive(si);
-      break;
+      return &marscirce_generate_moves_enforce_rex_exclusive;
 
     case STPhantomAvoidDuplicateMoves:
-      phantom_avoid_duplicate_moves(si);
-      break;
+      return &phantom_avoid_duplicate_moves;
 
     case STPlusAdditionalCapturesForPieceGenerator:
-      plus_generate_additional_captures_for_piece(si);
-      break;
+      return &plus_generate_additional_captures_for_piece;
 
     case STMoveForPieceGeneratorTwoPaths:
-      generate_moves_for_piece_two_paths(si);
-      break;
+      return &generate_moves_for_piece_two_paths;
 
     case STMarsCirceRememberRebirth:
-      marscirce_remember_rebirth(si);
-      break;
+      return &marscirce_remember_rebirth;
 
     case STMarsCirceRememberNoRebirth:
-      marscirce_remember_no_rebirth(si);
-      break;
+      return &marscirce_remember_no_rebirth;
 
     case STMarsCirceFixDeparture:
-      marscirce_fix_departure(si);
-      break;
+      return &marscirce_fix_departure;
 
     case STMarsCirceGenerateFromRebirthSquare:
-      marscirce_generate_from_rebirth_square(si);
-      break;
+      return &marscirce_generate_from_rebirth_square;
 
     case STMoveGeneratorRejectCaptures:
-      move_generation_reject_captures(si);
-      break;
+      return &move_generation_reject_captures;
 
     case STMoveGeneratorRejectNoncaptures:
-      move_generation_reject_non_captures(si);
-      break;
+      return &move_generation_reject_non_captures;
 
     case STVaultingKingsMovesForPieceGenerator:
-      vaulting_kings_generate_moves_for_piece(si);
-      break;
+      return &vaulting_kings_generate_moves_for_piece;
 
     case STTransmutingKingsMovesForPieceGenerator:
-      transmuting_kings_generate_moves_for_piece(si);
-      break;
+      return &transmuting_kings_generate_moves_for_piece;
 
     case STSuperTransmutingKingsMovesForPieceGenerator:
-      supertransmuting_kings_generate_moves_for_piece(si);
-      break;
+      return &supertransmuting_kings_generate_moves_for_piece;
 
     case STReflectiveKingsMovesForPieceGenerator:
-      reflective_kings_generate_moves_for_piece(si);
-      break;
+      return &reflective_kings_generate_moves_for_piece;
 
     case STCastlingChessMovesForPieceGenerator:
-      castlingchess_generate_moves_for_piece(si);
-      break;
+      return &castlingchess_generate_moves_for_piece;
 
     case STPlatzwechselRochadeMovesForPieceGenerator:
-      exchange_castling_generate_moves_for_piece(si);
-      break;
+      return &exchange_castling_generate_moves_for_piece;
 
     case STCastlingGenerator:
-      castling_generator_generate_castling(si);
-      break;
+      return &castling_generator_generate_castling;
 
     case STMessignyMovesForPieceGenerator:
-      messigny_generate_moves_for_piece(si);
-      break;
+      return &messigny_generate_moves_for_piece;
 
     case STAnnanMovesForPieceGenerator:
-      annan_generate_moves_for_piece(si);
-      break;
+      return &annan_generate_moves_for_piece;
 
     case STFaceToFaceMovesForPieceGenerator:
-      facetoface_generate_moves_for_piece(si);
-      break;
+      return &facetoface_generate_moves_for_piece;
 
     case STBackToBackMovesForPieceGenerator:
-      backtoback_generate_moves_for_piece(si);
-      break;
+      return &backtoback_generate_moves_for_piece;
 
     case STCheekToCheekMovesForPieceGenerator:
-      cheektocheek_generate_moves_for_piece(si);
-      break;
+      return &cheektocheek_generate_moves_for_piece;
 
     case STMovesForPieceBasedOnWalkGenerator:
-      generate_moves_for_piece_based_on_walk();
-      break;
+      return &generate_moves_for_piece_based_on_walk_solve;
 
     case STMoveGenerationPostMoveIterator:
-      move_generation_post_move_iterator_solve(si);
-      break;
+      return &move_generation_post_move_iterator_solve;
 
     /* square observation */
     case STIsSquareObservedOrtho:
-      observation_result = is_square_observed_ortho(trait[nbply],
-                                                    move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture);
-      break;
+      return &is_square_observed_ortho_solve;
 
     case STPlusIsSquareObserved:
-      plus_is_square_observed(si);
-      break;
+      return &plus_is_square_observed;
 
     case STMarsIterateObservers:
-      marscirce_iterate_observers(si);
-      break;
+      return &marscirce_iterate_observers;
 
     case STMarsCirceIsSquareObservedEnforceRexInclusive:
-      marscirce_is_square_observed_enforce_rex_exclusive(si);
-      break;
+      return &marscirce_is_square_observed_enforce_rex_exclusive;
 
     case STMarsIsSquareObserved:
-      marscirce_is_square_observed(si);
-      break;
+      return &marscirce_is_square_observed;
 
     case STVaultingKingIsSquareObserved:
-      vaulting_king_is_square_observed(si);
-      break;
+      return &vaulting_king_is_square_observed;
 
     case STTransmutingKingIsSquareObserved:
-      transmuting_king_is_square_observed(si);
-      break;
+      return &transmuting_king_is_square_observed;
 
     case STTransmutingKingDetectNonTransmutation:
-      transmuting_king_detect_non_transmutation(si);
-      break;
+      return &transmuting_king_detect_non_transmutation;
 
     case STDetermineObserverWalk:
-      determine_observer_walk(si);
-      break;
+      return &determine_observer_walk;
 
     case STBicoloresTryBothSides:
-      bicolores_try_both_sides(si);
-      break;
+      return &bicolores_try_both_sides;
 
     case STDontTryObservingWithNonExistingWalk:
-      dont_try_observing_with_non_existing_walk(si);
-      break;
+      return &dont_try_observing_with_non_existing_walk;
 
     case STDontTryObservingWithNonExistingWalkBothSides:
-      dont_try_observing_with_non_existing_walk_both_sides(si);
-      break;
+      return &dont_try_observing_with_non_existing_walk_both_sides;
 
     case STOptimiseObservationsByQueenInitialiser:
-      optimise_away_observations_by_queen_initialise(si);
-      break;
+      return &optimise_away_observations_by_queen_initialise;
 
     case STOptimiseObservationsByQueen:
-      optimise_away_observations_by_queen(si);
-      break;
+      return &optimise_away_observations_by_queen;
 
     case STTrackBackFromTargetAccordingToObserverWalk:
-      track_back_from_target_according_to_observer_walk(si);
-      break;
+      return &track_back_from_target_according_to_observer_walk;
 
     case STIsSquareObservedTwoPaths:
-      is_square_observed_two_paths(si);
-      break;
+      return &is_square_observed_two_paths;
 
     case STSquareObservationPostMoveIterator:
-      square_observation_post_move_iterator_solve(si);
-      break;
+      return &square_observation_post_move_iterator_solve;
 
     default:
       assert(0);
-      break;
+      return 0;
   }
 }
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ * @note the solving function is looked up only when a slice is solved for the
+ *       first time; afterwards it is called directly through the slice
+ */
+void dispatch(slice_index si)
+{
+  TraceEnumerator(slice_type,SLICE_TYPE(si));
+  TraceEOL();
+
+  if (SLICE_SOLVER(si)==0)
+    SLICE_SOLVER(si) = find_solver(SLICE_TYPE(si));
+
+  (*SLICE_SOLVER(si))(si);
+}
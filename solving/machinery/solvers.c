@@ -136,6 +136,8 @@
 #include "solving/battle_play/continuation.h"
 #include "solving/battle_play/setplay.h"
 #include "solving/battle_play/min_length_guard.h"
+#include "solving/battle_play/key_candidates.h"
+#include "solving/workers.h"
 #include "solving/boolean/and.h"
 #include "solving/goals/prerequisite_guards.h"
 #include "solving/trivial_end_filter.h"
@@ -180,9 +182,13 @@
 #include "optimisations/goals/remove_non_reachers.h"
 #include "optimisations/detect_retraction.h"
 #include "optimisations/observation.h"
+#include "optimisations/orthodox_legal_moves.h"
+#include "optimisations/king_square_attack_cache.h"
+#include "optimisations/no_op_slices.h"
 #include "debugging/assert.h"
 #include "debugging/trace.h"
 #include "debugging/measure.h"
+#include "debugging/statistics.h"
 
 /* Instrument the slices representing the stipulation with solving slices
  * @param solving_machinery proxy slice into the solving machinery to be built
@@ -277,7 +283,11 @@ void build_solvers1(slice_index si)
   else if (CondFlag[OWU])
     owu_replace_immobility_testers(si);
   else
+  {
     immobility_testers_substitute_king_first(si);
+    if (orthodox_legal_moves_are_applicable())
+      immobility_testers_generate_orthodox_legal_moves(si);
+  }
 
   if (CondFlag[exclusive])
     optimise_away_unnecessary_selfcheckguards(si);
@@ -659,6 +669,10 @@ void build_solvers2(slice_index si)
 
   and_enable_shortcut_logic(si);
 
+  workers_init_distribution(si);
+  if (workers_are_used())
+    solving_distribute_key_candidates(si);
+
   solving_insert_avoid_unsolvable_forks(si);
 
   solving_insert_move_iterators(si);
@@ -725,6 +739,8 @@ void build_solvers2(slice_index si)
   solving_insert_move_counters(si);
 #endif
 
+  solving_insert_statistics_counters(si);
+
   if (CondFlag[shieldedkings])
     shielded_kings_initialise_solving(si);
 
@@ -753,6 +769,10 @@ void build_solvers2(slice_index si)
 
   optimise_is_square_observed(si);
   optimise_is_in_check(si);
+  if (orthodox_legal_moves_are_applicable())
+    solving_insert_king_square_attack_cache(si);
+
+  solving_remove_no_op_slices(si);
 
   solving_impose_starter(si,SLICE_STARTER(si));
 
@@ -1696,6 +1696,8 @@ void initialise_piece_flags_solve(slice_index si)
 void pieces_counter_solve(slice_index si)
 {
   countPieces();
+  /* make sure that the bitboards match the board however it was set up */
+  recompute_bitboards();
   pipe_solve_delegate(si);
 }
 
@@ -28,17 +28,6 @@
 #include "debugging/trace.h"
 #include "debugging/assert.h"
 
-move_effect_journal_entry_type move_effect_journal[move_effect_journal_size];
-
-/* starting at 1 simplifies pointer arithmetic in undo_move_effects */
-move_effect_journal_index_type move_effect_journal_base[maxply+1] = { 1, 1 };
-
-move_effect_journal_index_type move_effect_journal_index_offset_capture = 0;
-move_effect_journal_index_type move_effect_journal_index_offset_movement = 1;
-move_effect_journal_index_type move_effect_journal_index_offset_other_effects = 2;
-
-move_effect_journal_index_type king_square_horizon;
-
 /* Reserve space for an effect in each move before the capture (e.g. for
  * Singlebox Type 3 promotions). Conditions that do this have to make sure
  * that every move has such an effect, possibly by adding a null effect to
@@ -74,10 +63,6 @@ void move_effect_journal_reset(slice_index si)
   TraceFunctionResultEnd();
 }
 
-#if defined(DOTRACE)
-unsigned long move_effect_journal_next_id;
-#endif
-
 /* Allocate an entry
  * @param type type of the effect
  * @param reason reason of the effect
@@ -637,6 +622,13 @@ static void redo_piece_exchange(move_effect_journal_entry_type const *entry)
   TraceFunctionResultEnd();
 }
 
+static void change_side_of_piece(square on)
+{
+  Flags spec = being_solved.spec[on];
+  piece_change_side(&spec);
+  replace_flags(on,spec);
+}
+
 /* Add changing the side of a piece to the current move of the current ply
  * @param reason reason for changing the piece's nature
  * @param on position of the piece to be changed
@@ -658,8 +650,7 @@ void move_effect_journal_do_side_change(move_effect_reason_type reason, square o
   entry->u.side_change.to = to;
 
   --being_solved.number_of_pieces[advers(to)][get_walk_of_piece_on_square(on)];
-  piece_change_side(&being_solved.spec[on]);
-  occupy_square(on,get_walk_of_piece_on_square(on),being_solved.spec[on]);
+  change_side_of_piece(on);
   ++being_solved.number_of_pieces[to][get_walk_of_piece_on_square(on)];
 
   TraceFunctionExit(__func__);
@@ -675,8 +666,7 @@ static void undo_side_change(move_effect_journal_entry_type const *entry)
   TraceFunctionParamListEnd();
 
   --being_solved.number_of_pieces[advers(from)][get_walk_of_piece_on_square(on)];
-  piece_change_side(&being_solved.spec[on]);
-  occupy_square(on,get_walk_of_piece_on_square(on),being_solved.spec[on]);
+  change_side_of_piece(on);
   ++being_solved.number_of_pieces[from][get_walk_of_piece_on_square(on)];
 
   TraceFunctionExit(__func__);
@@ -692,8 +682,7 @@ static void redo_side_change(move_effect_journal_entry_type const *entry)
   TraceFunctionParamListEnd();
 
   --being_solved.number_of_pieces[advers(to)][get_walk_of_piece_on_square(on)];
-  piece_change_side(&being_solved.spec[on]);
-  occupy_square(on,get_walk_of_piece_on_square(on),being_solved.spec[on]);
+  change_side_of_piece(on);
   ++being_solved.number_of_pieces[to][get_walk_of_piece_on_square(on)];
 
   TraceFunctionExit(__func__);
@@ -843,7 +832,7 @@ void move_effect_journal_do_flags_change(move_effect_reason_type reason,
   if (TSTFLAG(being_solved.spec[on],Black))
     --being_solved.number_of_pieces[Black][get_walk_of_piece_on_square(on)];
 
-  being_solved.spec[on] = to;
+  replace_flags(on,to);
 
   if (TSTFLAG(being_solved.spec[on],White))
     ++being_solved.number_of_pieces[White][get_walk_of_piece_on_square(on)];
@@ -873,7 +862,7 @@ static void undo_flags_change(move_effect_journal_entry_type const *entry)
   if (TSTFLAG(being_solved.spec[on],Black))
     --being_solved.number_of_pieces[Black][get_walk_of_piece_on_square(on)];
 
-  being_solved.spec[on] = from;
+  replace_flags(on,from);
 
   if (TSTFLAG(being_solved.spec[on],White))
     ++being_solved.number_of_pieces[White][get_walk_of_piece_on_square(on)];
@@ -900,7 +889,7 @@ static void redo_flags_change(move_effect_journal_entry_type const *entry)
   if (TSTFLAG(being_solved.spec[on],Black))
     --being_solved.number_of_pieces[Black][get_walk_of_piece_on_square(on)];
 
-  being_solved.spec[on] = to;
+  replace_flags(on,to);
 
   if (TSTFLAG(being_solved.spec[on],White))
     ++being_solved.number_of_pieces[White][get_walk_of_piece_on_square(on)];
@@ -1086,8 +1075,7 @@ static void do_polish(void)
       {
         Side const to = TSTFLAG(being_solved.spec[*bnp],White) ? Black : White;
         --being_solved.number_of_pieces[advers(to)][get_walk_of_piece_on_square(*bnp)];
-        piece_change_side(&being_solved.spec[*bnp]);
-        occupy_square(*bnp,get_walk_of_piece_on_square(*bnp),being_solved.spec[*bnp]);
+        change_side_of_piece(*bnp);
         ++being_solved.number_of_pieces[to][get_walk_of_piece_on_square(*bnp)];
       }
   }
@@ -1187,6 +1175,9 @@ static void do_shift(square from, square to)
       being_solved.board[*bnp] = board[*bnp];
       being_solved.spec[*bnp] = spec[*bnp];
     }
+
+  recompute_hash_key();
+  recompute_bitboards();
 }
 
 /* Execute a twinning that shifts the entire position
@@ -282,19 +282,11 @@ enum
   move_effect_journal_size = 10*maxply
 };
 
-/* the journal */
-extern move_effect_journal_entry_type move_effect_journal[move_effect_journal_size];
-
-/* index of next effect per ply (i.e. 1 position beyond the last effect) */
-extern move_effect_journal_index_type move_effect_journal_base[maxply+1];
-
-extern move_effect_journal_index_type move_effect_journal_index_offset_capture;
-extern move_effect_journal_index_type move_effect_journal_index_offset_movement;
-extern move_effect_journal_index_type move_effect_journal_index_offset_other_effects;
-
-#if defined(DOTRACE)
-extern unsigned long move_effect_journal_next_id;
-#endif
+/* The journal (move_effect_journal[]), the index of the next effect per ply
+ * (move_effect_journal_base[], i.e. 1 position beyond the last effect), the
+ * offsets of the capture, movement and other effects of a move and
+ * king_square_horizon are part of the solving context (cf. solving/context.h).
+ */
 
 /* Reserve space for an effect in each move before the capture (e.g. for
  * Singlebox Type 3 promotions). Conditions that do this have to make sure
@@ -511,8 +503,6 @@ void undo_move_effects(void);
 void redo_move_effects(void);
 
 
-extern move_effect_journal_index_type king_square_horizon;
-
 /* Update the king squares according to the effects since king_square_horizon
  * @note Updates king_square_horizon; solvers invoking this function should
  *       reset king_square_horizon to its previous value before returning
@@ -541,4 +531,8 @@ void king_square_updater_solve(slice_index si);
  */
 square move_effect_journal_get_departure_square(ply ply);
 
+/* the state of this module is part of the solving context */
+#define SOLVING_MOVE_EFFECT_JOURNAL_H_COMPLETE
+#include "solving/context.h"
+
 #endif
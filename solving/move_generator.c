@@ -17,15 +17,6 @@
 #include <string.h>
 #include <stdio.h>
 
-move_generation_elmt *curr_generation = &move_generation_stack[toppile];
-
-move_generation_elmt move_generation_stack[toppile + 1];
-
-numecoup current_move[maxply+1];
-numecoup current_move_id[maxply+1];
-
-piece_walk_type move_generation_current_walk;
-
 static void write_history_recursive(ply ply)
 {
   if (parent_ply[ply]>ply_retro_move)
@@ -50,6 +41,7 @@ void move_generator_write_history(void)
 static slice_index const slice_rank_order[] =
 {
     STGeneratingMovesForPiece,
+    STStatisticsMoveGenerationCounter,
     STSingleBoxType3TMovesForPieceGenerator,
     STMadrasiMovesForPieceGenerator,
     STEiffelMovesForPieceGenerator,
@@ -357,20 +349,18 @@ slice_index alloc_move_generator_slice(void)
 
 static void genmove(void)
 {
-  unsigned int i;
-  square square_h = square_h8;
-  Side const side = trait[nbply];
+  /* the bitboard of the side serves as the list of its pieces; visiting them
+   * in the order of decreasing bit indices means from h8 to a1 */
+  bitboard_type pieces = being_solved.bitboards.side[trait[nbply]];
 
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  for (i = nr_rows_on_board; i>0; i--, square_h += dir_down)
+  while (pieces!=0)
   {
-    unsigned int j;
-    square sq_departure = square_h;
-    for (j = nr_files_on_board; j>0; j--, sq_departure += dir_left)
-      if (TSTFLAG(being_solved.spec[sq_departure],side))
-        generate_moves_for_piece(sq_departure);
+    unsigned int const idx = bitboard_highest_index(pieces);
+    generate_moves_for_piece(bitboard_square(idx));
+    pieces ^= (bitboard_type)1<<idx;
   }
 
   TraceFunctionExit(__func__);
@@ -571,6 +561,7 @@ void push_move(void)
   INCREMENT_COUNTER(add_to_move_generation_stack);
 
   assert(current_move[nbply]<toppile);
+  assert(current_move_id[nbply]<(1u<<move_id_bits));
 
   TraceSquare(curr_generation->departure);
   TraceSquare(curr_generation->arrival);
@@ -597,6 +588,7 @@ void push_move_capture_extra(square sq_capture)
   INCREMENT_COUNTER(add_to_move_generation_stack);
 
   assert(current_move[nbply]<toppile);
+  assert(current_move_id[nbply]<(1u<<move_id_bits));
 
   TraceSquare(curr_generation->departure);
   TraceSquare(curr_generation->arrival);
@@ -623,6 +615,7 @@ void push_special_move(square sq_special)
   INCREMENT_COUNTER(add_to_move_generation_stack);
 
   assert(current_move[nbply]<toppile);
+  assert(current_move_id[nbply]<(1u<<move_id_bits));
 
   TraceSquare(curr_generation->departure);
   TraceSquare(curr_generation->arrival);
@@ -676,10 +669,9 @@ void pop_all(void)
   current_move[nbply] = current_move[nbply-1];
 }
 
-typedef unsigned int mark_type;
-
-static mark_type square_marks[square_h8+1] = { 0 };
-static mark_type current_mark = 0;
+/* our part of the solving context that isn't used by other modules */
+#define square_marks (solving_context.square_marks)
+#define current_mark (solving_context.current_mark)
 
 static boolean is_not_duplicate(numecoup n)
 {
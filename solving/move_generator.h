@@ -22,30 +22,43 @@ enum
   offset_platzwechsel_rochade = 2*maxsquare
 };
 
-typedef struct
+enum
 {
-    numecoup id;
-    square departure;
-    square arrival;
-    square capture;
-} move_generation_elmt;
+  toppile = 60*maxply
+};
 
+/* The elements of the move generation stack are packed into 8 bytes so that
+ * the moves of a ply occupy as few cache lines as possible. The fields are
+ * accessed as usual, but their addresses can't be taken.
+ */
 enum
 {
-  toppile = 60*maxply
+  /* move ids are allocated like the positions in the stack; they are used
+   * for indexing per move information in arrays of size toppile+1 */
+  move_id_bits = 20,
+
+  /* wide enough for all squares and the special values of capture (e.g.
+   * offset_platzwechsel_rochade+square_h8) */
+  move_square_bits = 12
 };
 
-extern move_generation_elmt move_generation_stack[toppile + 1];
+typedef struct
+{
+    numecoup id: move_id_bits;
+    signed int departure: move_square_bits;
+    signed int arrival: move_square_bits;
+    signed int capture: move_square_bits;
+} move_generation_elmt;
 
 enum
 {
   current_generation = toppile
 };
 
-extern piece_walk_type move_generation_current_walk;
-
-extern numecoup current_move[maxply+1];
-extern numecoup current_move_id[maxply+1];
+/* move_generation_stack, curr_generation, move_generation_current_walk,
+ * current_move and current_move_id are part of the solving context
+ * (cf. solving/context.h)
+ */
 
 #define MOVEBASE_OF_PLY(ply) (current_move[(ply)-1])
 #define SET_MOVEBASE_OF_PLY(ply,n) (current_move[(ply)-1] = n)
@@ -182,9 +195,6 @@ void move_generator_filter_noncaptures(numecoup start,
  */
 void move_generator_invert_move_order(ply ply);
 
-/* address of an element used for holding the move currently being generated */
-extern move_generation_elmt *curr_generation;
-
 /* Pop the topmost move */
 void pop_move(void);
 
@@ -237,4 +247,8 @@ void remove_duplicate_moves_of_single_piece(numecoup start);
  */
 void move_generator_priorise(numecoup priorised);
 
+/* the state of this module is part of the solving context */
+#define SOLVING_MOVE_GENERATOR_H_COMPLETE
+#include "solving/context.h"
+
 #endif
@@ -9,15 +9,10 @@
 #include "debugging/assert.h"
 #include <string.h>
 
-ply nbply = ply_nil;
-
-ply parent_ply[maxply+1];
-
-Side trait[maxply+1];
-
-static ply ply_watermark;
-static ply ply_stack[maxply+1];
-static ply ply_stack_pointer;
+/* our part of the solving context that isn't used by other modules */
+#define ply_watermark (solving_context.ply_watermark)
+#define ply_stack (solving_context.ply_stack)
+#define ply_stack_pointer (solving_context.ply_stack_pointer)
 
 /* resset the ply module */
 void ply_reset(void)
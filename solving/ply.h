@@ -36,12 +36,10 @@ enum
   ply_retro_move
 };
 
-/* the current ply */
-extern ply nbply;
-
-extern ply parent_ply[maxply+1];
-
-extern Side trait[maxply+1];
+/* The current ply (nbply), the parent of each ply (parent_ply[]) and the side
+ * at the move in each ply (trait[]) are part of the solving context
+ * (cf. solving/context.h).
+ */
 
 /* resset the ply module */
 void ply_reset(void);
@@ -64,4 +62,8 @@ void siblingply(Side side);
 /* End the current ply, making the previous current ply the current ply again */
 void finply(void);
 
+/* the state of this module is part of the solving context */
+#define SOLVING_PLY_H_COMPLETE
+#include "solving/context.h"
+
 #endif
@@ -47,6 +47,14 @@ static struct
 
 static unsigned int ProofNbrAllPieces;
 
+static void restore_position(position const *pos)
+{
+  being_solved = *pos;
+
+  /* we don't know which squares differ from the position replaced */
+  being_solved.bitboards.modified = ~(bitboard_type)0;
+}
+
 static void override_standard_walk(square s, Side side, piece_walk_type orthodox_walk)
 {
   piece_walk_type const overriding_walk = standard_walks[orthodox_walk];
@@ -72,7 +80,7 @@ void ProofRestoreStartPosition(void)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  being_solved = proofgames_start_position;
+  restore_position(&proofgames_start_position);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -83,7 +91,7 @@ void ProofRestoreTargetPosition(void)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  being_solved = proofgames_target_position;
+  restore_position(&proofgames_target_position);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -227,7 +235,7 @@ void move_effect_journal_undo_snapshot_proofgame_target_position(move_effect_jou
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  being_solved = proofgames_target_position;
+  restore_position(&proofgames_target_position);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -313,6 +321,10 @@ void proof_initialise_start_position(slice_index si)
   override_standard_walk(square_g7,Black,Pawn);
   override_standard_walk(square_h7,Black,Pawn);
 
+  proofgames_start_position.hash_key = calculate_hash_key(&proofgames_start_position);
+  calculate_bitboards(&proofgames_start_position,
+                      &proofgames_start_position.bitboards);
+
   pipe_solve_delegate(si);
 
   TraceFunctionExit(__func__);
@@ -340,7 +352,7 @@ void proof_solve(slice_index si)
 
   move_effect_journal_do_snapshot_proofgame_target_position(move_effect_reason_diagram_setup);
 
-  being_solved = proofgames_start_position;
+  restore_position(&proofgames_start_position);
 
   initialise_target_pieces_cache();
 
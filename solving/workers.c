@@ -0,0 +1,457 @@
+#include "solving/workers.h"
+#include "solving/incomplete.h"
+#include "output/plaintext/protocol.h"
+#include "platform/worker.h"
+#include "platform/tmpfile.h"
+#include "platform/maxtime.h"
+#include "options/options.h"
+#include "debugging/statistics.h"
+#include "stipulation/structure_traversal.h"
+#include "debugging/trace.h"
+#include "debugging/assert.h"
+
+#include <stdlib.h>
+
+enum
+{
+  no_worker = -1
+};
+
+typedef struct
+{
+    int worker;          /* no_worker if the task hasn't been claimed yet */
+    unsigned long start; /* where the task's output starts in the worker's output file */
+    unsigned long end;   /* where it ends */
+} task_type;
+
+/* incompleteness of solving reported in a worker */
+typedef struct
+{
+    slice_index reporter;
+    solving_completeness_type completeness;
+} incompleteness_type;
+
+/* state shared between the parent and the workers of a distribution */
+typedef struct
+{
+    unsigned long volatile next_unclaimed_task;
+    stip_length_type *results;
+    incompleteness_type *incompleteness;
+    task_type *tasks;
+} shared_state_type;
+
+static unsigned int nr_workers_requested = 1;
+static boolean is_distribution_enabled;
+
+static shared_state_type *shared_state;
+static size_t shared_state_size;
+
+static unsigned long nr_distributed_tasks;
+static FILE **worker_outputs;
+static unsigned int nr_workers_started;
+
+static boolean is_worker;
+static unsigned int current_worker;
+static boolean has_current_worker_claimed;
+static unsigned long task_claimed;
+
+/* Set the number of worker processes to be used
+ * @param nr number of workers; 0 and 1 both mean: don't use workers
+ */
+void workers_set_number(unsigned int nr)
+{
+  nr_workers_requested = nr;
+}
+
+static void remember_latex_writer(slice_index si, stip_structure_traversal *st)
+{
+  boolean * const is_latex_written = st->param;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  *is_latex_written = true;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* The workers' output is merged in the plaintext output; the LaTeX file is
+ * written by the LaTeX writer slices directly.
+ */
+static boolean is_latex_written(slice_index si)
+{
+  boolean result = false;
+  stip_structure_traversal st;
+
+  stip_structure_traversal_init(&st,&result);
+  stip_structure_traversal_override_single(&st,
+                                           STOutputLaTeXKeyWriter,
+                                           &remember_latex_writer);
+  stip_structure_traversal_override_single(&st,
+                                           STOutputLaTeXTryWriter,
+                                           &remember_latex_writer);
+  stip_structure_traversal_override_single(&st,
+                                           STOutputLaTeXLineLineWriter,
+                                           &remember_latex_writer);
+  stip_traverse_structure(si,&st);
+
+  return result;
+}
+
+/* These options count solutions or interrupt solving, which can't be done
+ * consistently across workers. The solving statistics are only collected in
+ * the parent process.
+ */
+static boolean are_options_compatible(void)
+{
+  return !(OptFlag[maxsols]
+           || OptFlag[stoponshort]
+           || OptFlag[movenbr]
+           || OptFlag[maxtime]
+           || platform_is_maxtime_set()
+           || statistics_is_report_requested());
+}
+
+/* Find out whether solving with a solving machinery can be distributed to
+ * worker processes
+ * @param si identifies the root slice of the solving machinery
+ */
+void workers_init_distribution(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  is_distribution_enabled = (nr_workers_requested>1
+                             && platform_are_workers_supported()
+                             && are_options_compatible()
+                             && !is_latex_written(si));
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine the number of worker processes to be used
+ * @return number of workers
+ */
+unsigned int workers_get_nr_requested(void)
+{
+  return nr_workers_requested;
+}
+
+/* Determine whether the invoking process is a worker process
+ * @return true iff the invoking process is a worker
+ */
+boolean workers_is_worker(void)
+{
+  return is_worker;
+}
+
+/* Determine whether solving is to be distributed to worker processes
+ * @return true iff more than 1 worker is to be used, and the platform, the
+ *         options and the output of the current solving machinery allow it
+ */
+boolean workers_are_used(void)
+{
+  return is_distribution_enabled;
+}
+
+static boolean allocate_shared_state(void)
+{
+  size_t const size_results = nr_workers_requested*sizeof *shared_state->results;
+  size_t const size_incompleteness = nr_workers_requested*sizeof *shared_state->incompleteness;
+  size_t const size_tasks = nr_distributed_tasks*sizeof *shared_state->tasks;
+
+  shared_state_size = (sizeof *shared_state
+                       + size_results + size_incompleteness + size_tasks);
+  shared_state = platform_allocate_shared_memory(shared_state_size);
+  if (shared_state==0)
+    return false;
+  else
+  {
+    unsigned long i;
+
+    shared_state->next_unclaimed_task = 0;
+    shared_state->results = (stip_length_type *)(shared_state+1);
+    shared_state->incompleteness = (incompleteness_type *)((char *)shared_state->results+size_results);
+    shared_state->tasks = (task_type *)((char *)shared_state->incompleteness+size_incompleteness);
+
+    for (i = 0; i!=nr_workers_requested; ++i)
+    {
+      shared_state->results[i] = 0;
+      shared_state->incompleteness[i].reporter = no_slice;
+      shared_state->incompleteness[i].completeness = solving_complete;
+    }
+
+    for (i = 0; i!=nr_distributed_tasks; ++i)
+    {
+      shared_state->tasks[i].worker = no_worker;
+      shared_state->tasks[i].start = 0;
+      shared_state->tasks[i].end = 0;
+    }
+
+    return true;
+  }
+}
+
+static void free_shared_state(void)
+{
+  platform_free_shared_memory(shared_state,shared_state_size);
+  shared_state = 0;
+  shared_state_size = 0;
+}
+
+static void start_workers(void)
+{
+  worker_outputs = malloc(nr_workers_requested*sizeof *worker_outputs);
+  nr_workers_started = 0;
+
+  if (worker_outputs!=0)
+    while (nr_workers_started<nr_workers_requested)
+    {
+      FILE * const output = platform_open_tmpfile();
+      if (output==0)
+        break;
+      else
+        switch (platform_start_worker(output))
+        {
+          case worker_start_in_worker:
+            is_worker = true;
+            current_worker = nr_workers_started;
+            has_current_worker_claimed = false;
+            /* our parent writes our output to the protocol file (if any) */
+            protocol_detach();
+            return;
+
+          case worker_start_in_parent:
+            worker_outputs[nr_workers_started] = output;
+            ++nr_workers_started;
+            break;
+
+          case worker_start_failed:
+            platform_close_tmpfile(output);
+            return;
+
+          default:
+            assert(0);
+            break;
+        }
+    }
+}
+
+/* Write the output of the tasks in the order of the tasks
+ */
+static void merge_output(void)
+{
+  unsigned long i;
+
+  for (i = 0; i!=nr_distributed_tasks; ++i)
+  {
+    task_type const * const task = shared_state->tasks+i;
+    if (task->worker!=no_worker)
+    {
+      FILE * const output = worker_outputs[task->worker];
+      unsigned long pos;
+
+      fseek(output,(long)task->start,SEEK_SET);
+      for (pos = task->start; pos!=task->end; ++pos)
+      {
+        int const c = getc(output);
+        if (c==EOF)
+          break;
+        else
+          protocol_fputc(c,stdout);
+      }
+    }
+  }
+
+  protocol_fflush(stdout);
+}
+
+/* Report the incompleteness of solving reported in the workers as if it had
+ * been reported in the parent
+ */
+static void take_over_incompleteness(void)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_workers_started; ++i)
+  {
+    incompleteness_type const * const incompleteness = shared_state->incompleteness+i;
+    if (incompleteness->completeness!=solving_complete)
+      phase_solving_remember_incompleteness(incompleteness->reporter,
+                                            incompleteness->completeness);
+  }
+}
+
+/* Distribute some tasks to the workers
+ * @param nr_tasks number of tasks
+ * @return workers_distribution_in_worker in each worker process; the worker
+ *            is then supposed to visit the tasks, solve those that
+ *            workers_claim_task() allows it to solve and finally invoke
+ *            workers_end_worker()
+ *         workers_distribution_in_parent in the parent process, after all
+ *            workers have terminated and the output of all tasks has been
+ *            written; the parent has to invoke workers_end_distribution()
+ *            after having retrieved the workers' results
+ *         workers_distribution_failed if no worker could be started (or we
+ *            are in a worker process already)
+ */
+workers_distribution_type workers_distribute(unsigned long nr_tasks)
+{
+  workers_distribution_type result = workers_distribution_failed;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%lu",nr_tasks);
+  TraceFunctionParamListEnd();
+
+  assert(shared_state==0 || is_worker);
+
+  if (!is_worker)
+  {
+    nr_distributed_tasks = nr_tasks;
+
+    if (allocate_shared_state())
+    {
+      start_workers();
+
+      if (is_worker)
+        result = workers_distribution_in_worker;
+      else if (nr_workers_started==0)
+        workers_end_distribution();
+      else
+      {
+        platform_wait_for_workers();
+        merge_output();
+        take_over_incompleteness();
+        result = workers_distribution_in_parent;
+      }
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Find out whether the current worker is to solve a task. Workers have to visit
+ * the tasks in ascending order; a task may be visited repeatedly.
+ * @param task identifies the task
+ * @return true iff the current worker is to solve the task
+ */
+boolean workers_claim_task(unsigned long task)
+{
+  boolean result;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%lu",task);
+  TraceFunctionParamListEnd();
+
+  assert(is_worker);
+  assert(task<nr_distributed_tasks);
+
+  /* Tasks are claimed in ascending order, and we only claim a new task once
+   * we have passed the one claimed before. Any task that we skip has therefore
+   * been claimed by another worker.
+   */
+  while (!has_current_worker_claimed || task_claimed<task)
+  {
+    task_claimed = platform_fetch_and_increment(&shared_state->next_unclaimed_task);
+    has_current_worker_claimed = true;
+  }
+
+  result = task_claimed==task;
+
+  if (result && shared_state->tasks[task].worker==no_worker)
+  {
+    unsigned long const pos = platform_get_worker_output_position();
+    shared_state->tasks[task].worker = (int)current_worker;
+    shared_state->tasks[task].start = pos;
+    shared_state->tasks[task].end = pos;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Report that the current worker has (for now) done solving a task that it has
+ * claimed
+ * @param task identifies the task
+ */
+void workers_end_task(unsigned long task)
+{
+  assert(is_worker);
+  assert(shared_state->tasks[task].worker==(int)current_worker);
+
+  shared_state->tasks[task].end = platform_get_worker_output_position();
+}
+
+/* Remember that solving in the current worker has been incomplete
+ * @param si identifies the reporting slice
+ * @param c completeness of phase
+ */
+void workers_remember_incompleteness(slice_index si,
+                                     solving_completeness_type c)
+{
+  incompleteness_type * const incompleteness = shared_state->incompleteness+current_worker;
+
+  assert(is_worker);
+
+  if (incompleteness->completeness<c)
+  {
+    incompleteness->reporter = si;
+    incompleteness->completeness = c;
+  }
+}
+
+/* Terminate the current worker process
+ * @param result overall result of the tasks solved by the worker
+ */
+void workers_end_worker(stip_length_type result)
+{
+  assert(is_worker);
+
+  shared_state->results[current_worker] = result;
+  platform_end_worker();
+}
+
+/* Determine the number of workers that have taken part in the distribution
+ * @return number of workers
+ */
+unsigned int workers_get_nr_workers(void)
+{
+  return nr_workers_started;
+}
+
+/* Retrieve the overall result reported by a worker
+ * @param worker identifies the worker (0<=worker<workers_get_nr_workers())
+ * @return the result; 0 if the worker hasn't reported a result
+ */
+stip_length_type workers_get_result(unsigned int worker)
+{
+  assert(worker<nr_workers_started);
+  return shared_state->results[worker];
+}
+
+/* Clean up after a distribution in the parent process
+ */
+void workers_end_distribution(void)
+{
+  unsigned int i;
+
+  assert(!is_worker);
+
+  for (i = 0; i!=nr_workers_started; ++i)
+    platform_close_tmpfile(worker_outputs[i]);
+
+  free(worker_outputs);
+  worker_outputs = 0;
+  nr_workers_started = 0;
+
+  free_shared_state();
+}
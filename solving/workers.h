@@ -0,0 +1,111 @@
+#if !defined(SOLVING_WORKERS_H)
+#define SOLVING_WORKERS_H
+
+/* This module distributes solving tasks (e.g. the key candidates of a battle
+ * play problem, or the squares of the black king in intelligent mode) to worker
+ * processes running in parallel.
+ *
+ * The tasks are numbered 0, 1, ... in the order in which the serial solver
+ * deals with them. Each worker starts with a copy of the solving state and
+ * visits the tasks in that order, but only solves the tasks it manages to
+ * claim, i.e. the ones not claimed by another worker yet. What a worker writes
+ * while solving a task is collected, and the parent process writes the output
+ * of all tasks in the task order once the workers have terminated. The output
+ * is therefore identical to the output of the serial solver.
+ */
+
+#include "stipulation/stipulation.h"
+#include "solving/incomplete.h"
+#include "utilities/boolean.h"
+
+typedef enum
+{
+  workers_distribution_failed, /* solve the tasks without workers */
+  workers_distribution_in_worker,
+  workers_distribution_in_parent
+} workers_distribution_type;
+
+/* Set the number of worker processes to be used
+ * @param nr number of workers; 0 and 1 both mean: don't use workers
+ */
+void workers_set_number(unsigned int nr);
+
+/* Find out whether solving with a solving machinery can be distributed to
+ * worker processes
+ * @param si identifies the root slice of the solving machinery
+ */
+void workers_init_distribution(slice_index si);
+
+/* Determine the number of worker processes to be used
+ * @return number of workers
+ */
+unsigned int workers_get_nr_requested(void);
+
+/* Determine whether the invoking process is a worker process
+ * @return true iff the invoking process is a worker
+ */
+boolean workers_is_worker(void);
+
+/* Determine whether solving is to be distributed to worker processes
+ * @return true iff more than 1 worker is to be used, and the platform, the
+ *         options and the output of the current solving machinery allow it
+ */
+boolean workers_are_used(void);
+
+/* Distribute some tasks to the workers
+ * @param nr_tasks number of tasks
+ * @return workers_distribution_in_worker in each worker process; the worker
+ *            is then supposed to visit the tasks, solve those that
+ *            workers_claim_task() allows it to solve and finally invoke
+ *            workers_end_worker()
+ *         workers_distribution_in_parent in the parent process, after all
+ *            workers have terminated and the output of all tasks has been
+ *            written; the parent has to invoke workers_end_distribution()
+ *            after having retrieved the workers' results
+ *         workers_distribution_failed if no worker could be started (or we
+ *            are in a worker process already)
+ */
+workers_distribution_type workers_distribute(unsigned long nr_tasks);
+
+/* Find out whether the current worker is to solve a task. Workers have to visit
+ * the tasks in ascending order; a task may be visited repeatedly.
+ * @param task identifies the task
+ * @return true iff the current worker is to solve the task
+ */
+boolean workers_claim_task(unsigned long task);
+
+/* Report that the current worker has (for now) done solving a task that it has
+ * claimed
+ * @param task identifies the task
+ */
+void workers_end_task(unsigned long task);
+
+/* Remember that solving in the current worker has been incomplete; the parent
+ * takes this over once the workers have terminated
+ * @param si identifies the reporting slice
+ * @param c completeness of phase
+ */
+void workers_remember_incompleteness(slice_index si,
+                                     solving_completeness_type c);
+
+/* Terminate the current worker process
+ * @param result overall result of the tasks solved by the worker
+ */
+void workers_end_worker(stip_length_type result);
+
+/* Determine the number of workers that have taken part in the distribution
+ * @return number of workers
+ */
+unsigned int workers_get_nr_workers(void);
+
+/* Retrieve the overall result reported by a worker
+ * @param worker identifies the worker (0<=worker<workers_get_nr_workers())
+ * @return the result; 0 if the worker hasn't reported a result
+ */
+stip_length_type workers_get_result(unsigned int worker);
+
+/* Clean up after a distribution in the parent process
+ */
+void workers_end_distribution(void);
+
+#endif
@@ -106,6 +106,7 @@ static slice_index const slice_rank_order[] =
   STPiecesParalysingSuffocationFinder,
   STPiecesParalysingRemoveCaptures,
   STMummerOrchestrator,
+  STOrthodoxRemoveIllegalMoves,
   STDoneRemovingIllegalMoves,
   STEnPassantRemoveNonReachers,
   STCastlingRemoveNonReachers,
@@ -115,10 +116,13 @@ static slice_index const slice_rank_order[] =
   STCageCirceFutileCapturesRemover,
   STDoneRemovingFutileMoves,
   STRetractionPrioriser,
+  STHistoryMovePrioriser,
   STKillerMovePrioriser,
   STDonePriorisingMoves,
+  STKeyCandidatesDistributor,
   STMove,
   STAttackPlayed,
+  STKeyCandidateClaimer,
   STMaxTimeGuard,
   STMaxSolutionsGuard,
   STMaxSolutionsCounter,
@@ -192,6 +196,7 @@ static slice_index const slice_rank_order[] =
   STBlackChecksNullMoveGenerator,
   STKingMoveGenerator,
   STSinglePieceMoveGenerator,
+  STStagedMoveGenerator,
   STDoneGeneratingMoves,
   STSuperTransmutingKingMoveGenerationFilter,
   STUncapturableRemoveCaptures,
@@ -219,10 +224,12 @@ static slice_index const slice_rank_order[] =
   STShieldedKingsRemoveIllegalCaptures,
   STSuperguardsRemoveIllegalCaptures,
   STMummerOrchestrator,
+  STOrthodoxRemoveIllegalMoves,
   STDoneRemovingIllegalMoves,
   STCageCirceFutileCapturesRemover,
   STDoneRemovingFutileMoves,
   STRetractionPrioriser,
+  STHistoryMovePrioriser,
   STKillerMovePrioriser,
   STOpponentMovesFewMovesPrioriser,
   STDonePriorisingMoves,
@@ -24,6 +24,7 @@ static slice_index const slice_rank_order[] =
   STConstraintSolver,
   STConstraintTester,
   STFindByIncreasingLength,
+  STStatisticsLengthCounter,
   STFindShortest,
   STStopOnShortSolutionsFilter,
   STIntelligentMovesLeftInitialiser,
@@ -38,10 +39,12 @@ static slice_index const slice_rank_order[] =
   STIntelligentProof,
   STMaxTimeGuard,
   STMaxSolutionsGuard,
+  STStatisticsTargetPositionCandidateCounter,
   STIntelligentMateTargetPositionTester,
   STIntelligentStalemateTargetPositionTester,
   STIntelligentSolutionsPerTargetPosInitialiser,
   STIntelligentTargetCounter,
+  STStatisticsTargetPositionCounter,
   STIntelligentTargetPositionFound,
   STHashOpener,
   STEndOfBranch,
@@ -97,6 +100,7 @@ static slice_index const slice_rank_order[] =
   STShieldedKingsRemoveIllegalCaptures,
   STSuperguardsRemoveIllegalCaptures,
   STMummerOrchestrator,
+  STOrthodoxRemoveIllegalMoves,
   STDoneRemovingIllegalMoves,
   STEnPassantRemoveNonReachers,
   STCastlingRemoveNonReachers,
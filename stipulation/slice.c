@@ -228,6 +228,7 @@ static slice_type const move_generator_slice_types[] =
     STOrthodoxMatingMoveGenerator,
     STOrthodoxMatingKingContactGenerator,
     STSinglePieceMoveGenerator,
+    STStagedMoveGenerator,
     STBlackChecksNullMoveGenerator
 };
 
@@ -235,6 +236,7 @@ static slice_type const move_reordering_optimiser_slice_types[] =
 {
     STOpponentMovesFewMovesPrioriser,
     STKillerMovePrioriser,
+    STHistoryMovePrioriser,
     STRetractionPrioriser
 };
 
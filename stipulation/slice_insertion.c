@@ -662,6 +662,7 @@ static slice_index const slice_rank_order[] =
 #if defined(DOMEASURE)
   STCountersWriter,
 #endif
+  STStatisticsWriter,
   STInputVerification,
   STMoveEffectsJournalReset,
   STSolversBuilder1,
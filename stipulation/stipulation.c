@@ -116,6 +116,7 @@ slice_index create_slice(slice_type type)
   SLICE_NEXT1(result) = no_slice;
   SLICE_NEXT2(result) = no_slice;
   SLICE_TESTER(result) = no_slice;
+  SLICE_SOLVER(result) = 0;
 
   TraceFunctionExit(__func__);
   TraceFunctionResult("%u",result);
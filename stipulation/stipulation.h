@@ -33,6 +33,9 @@ enum
 struct circe_variant_type;
 struct position;
 
+/* function solving a slice; cf. dispatch() */
+typedef void (*slice_solver_type)(slice_index si);
+
 typedef enum
 {
   twin_zeroposition,
@@ -48,6 +51,9 @@ typedef struct
     slice_index next2;
     slice_index tester;
 
+    /* looked up from the type when the slice is solved for the first time */
+    slice_solver_type solver;
+
     union
     {
         struct
@@ -172,6 +178,7 @@ extern Slice slices[max_nr_slices];
 #define SLICE_STARTER(si) slices[(si)].starter
 #define SLICE_TESTER(si) slices[(si)].tester
 #define SLICE_U(si) slices[(si)].u
+#define SLICE_SOLVER(si) slices[(si)].solver
 
 /* Dellocate a slice index
  * @param si slice index deallocated